@@ -0,0 +1,447 @@
+/*
+ * adaptive-set.cc: 
+ *
+ * Copyright (C) 2004 Marcus Nilsson (marcusn@it.uu.se)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ * 
+ * Authors:
+ *    Marcus Nilsson (marcusn@it.uu.se)
+ */
+
+
+#include <gbdd/adaptive-set.h>
+#include <algorithm>
+
+namespace gbdd
+{
+
+const unsigned int AdaptiveSet::max_sorted_size;
+const unsigned int AdaptiveSet::max_bitset_vars;
+
+/// Create empty set
+/**
+ * @param space Space of BDDs of the set
+ * @param vs Domain to encode values in, finite
+ */
+AdaptiveSet::AdaptiveSet(Space* space, const Domain& vs):
+	space(space),
+	vs(vs),
+	encoding(ENCODING_SORTED)
+{
+	assert(vs.is_finite());
+}
+
+/// Create set from BDD set
+/**
+ * @param s Set to copy
+ */
+AdaptiveSet::AdaptiveSet(const BddSet& s):
+	space(s.get_space()),
+	vs(s.get_domain()),
+	encoding(ENCODING_BDD),
+	bdd(s.get_bdd())
+{
+	assert(vs.is_finite());
+
+	adapt();
+}
+
+/// Test if the domain is small enough for a bitset
+/**
+ * @return Whether the domain has at most max_bitset_vars variables
+ */
+bool AdaptiveSet::is_bitset_allowed() const
+{
+	return vs.size() <= max_bitset_vars;
+}
+
+/// Get number of words of bitset
+/**
+ * @return Number of words for one bit per value of the domain
+ */
+unsigned int AdaptiveSet::n_bitset_words() const
+{
+	return vs.size() > 6 ? 1 << (vs.size() - 6) : 1;
+}
+
+/// Change encoding
+/**
+ * @param e New encoding
+ */
+void AdaptiveSet::set_encoding(Encoding e)
+{
+	if (e == encoding) return;
+
+	if (e == ENCODING_SORTED)
+	{
+		vector<unsigned int> new_values = get_values();
+		values.swap(new_values);
+	}
+	else if (e == ENCODING_BITSET)
+	{
+		assert(is_bitset_allowed());
+
+		bits.assign(n_bitset_words(), 0);
+
+		if (encoding == ENCODING_SORTED)
+		{
+			for (vector<unsigned int>::const_iterator i = values.begin();i != values.end();++i)
+			{
+				bits[*i >> 6] |= (uint64_t)1 << (*i & 0x3f);
+			}
+		}
+		else
+		{
+			bdd.to_truth_table(vs, &bits[0]);
+		}
+	}
+	else
+	{
+		if (encoding == ENCODING_BITSET)
+		{
+			bdd = Bdd::from_truth_table(space, vs, &bits[0]);
+		}
+		else
+		{
+			bdd = Bdd(space, false);
+
+			for (vector<unsigned int>::const_iterator i = values.begin();i != values.end();++i)
+			{
+				bdd |= Bdd::value(space, vs, *i);
+			}
+		}
+	}
+
+	if (e != ENCODING_SORTED) vector<unsigned int>().swap(values);
+	if (e != ENCODING_BITSET) vector<uint64_t>().swap(bits);
+	if (e != ENCODING_BDD) bdd = Bdd();
+
+	encoding = e;
+}
+
+/// Pick encoding by size
+/**
+ * A set is only moved back to a sorted array when it has at most
+ * half of max_sorted_size values, so that a set at the limit is not
+ * converted back and forth.
+ */
+void AdaptiveSet::adapt()
+{
+	if (encoding == ENCODING_SORTED)
+	{
+		if (values.size() > max_sorted_size)
+		{
+			set_encoding(is_bitset_allowed() ? ENCODING_BITSET : ENCODING_BDD);
+		}
+	}
+	else if (size() <= max_sorted_size / 2)
+	{
+		set_encoding(ENCODING_SORTED);
+	}
+	else if (encoding == ENCODING_BDD && is_bitset_allowed())
+	{
+		set_encoding(ENCODING_BITSET);
+	}
+}
+
+/// Insert value
+/**
+ * @param v Value, encodable in the domain
+ * 
+ * @return Whether \a v was not already in the set
+ */
+bool AdaptiveSet::insert(unsigned int v)
+{
+	assert(vs.size() >= 32 || v < (1U << vs.size()));
+
+	if (member(v)) return false;
+
+	switch (encoding)
+	{
+	case ENCODING_SORTED:
+		values.insert(lower_bound(values.begin(), values.end(), v), v);
+		adapt();
+		break;
+	case ENCODING_BITSET:
+		bits[v >> 6] |= (uint64_t)1 << (v & 0x3f);
+		break;
+	case ENCODING_BDD:
+		bdd |= Bdd::value(space, vs, v);
+		break;
+	}
+
+	return true;
+}
+
+/// Test membership
+/**
+ * @param v Value
+ * 
+ * @return Whether \a v is in the set
+ */
+bool AdaptiveSet::member(unsigned int v) const
+{
+	if (Bdd::n_vars_needed(v+1) > vs.size()) return false;
+
+	switch (encoding)
+	{
+	case ENCODING_SORTED:
+		return binary_search(values.begin(), values.end(), v);
+	case ENCODING_BITSET:
+		return v < (uint64_t)n_bitset_words() * 64 && ((bits[v >> 6] >> (v & 0x3f)) & 0x1);
+	default:
+		return bdd.value_member(vs, v);
+	}
+}
+
+/// Get size
+/**
+ * @return Number of values in the set
+ */
+unsigned int AdaptiveSet::size() const
+{
+	switch (encoding)
+	{
+	case ENCODING_SORTED:
+		return values.size();
+	case ENCODING_BITSET:
+	{
+		unsigned int n = 0;
+
+		for (vector<uint64_t>::const_iterator i = bits.begin();i != bits.end();++i)
+		{
+			n += __builtin_popcountll(*i);
+		}
+
+		return n;
+	}
+	default:
+		return bdd.n_assignments(vs);
+	}
+}
+
+/// Test for empty set
+/**
+ * @return Whether the set has no values
+ */
+bool AdaptiveSet::is_empty() const
+{
+	switch (encoding)
+	{
+	case ENCODING_SORTED:
+		return values.empty();
+	case ENCODING_BITSET:
+		for (vector<uint64_t>::const_iterator i = bits.begin();i != bits.end();++i)
+		{
+			if (*i != 0) return false;
+		}
+
+		return true;
+	default:
+		return bdd.is_false();
+	}
+}
+
+/// Get values
+/**
+ * @return The values of the set in increasing order
+ */
+vector<unsigned int> AdaptiveSet::get_values() const
+{
+	if (encoding == ENCODING_SORTED) return values;
+
+	vector<unsigned int> vals;
+
+	if (encoding == ENCODING_BITSET)
+	{
+		for (unsigned int i = 0;i < bits.size();++i)
+		{
+			for (uint64_t w = bits[i];w != 0;w &= w - 1)
+			{
+				vals.push_back(i * 64 + __builtin_ctzll(w));
+			}
+		}
+	}
+	else
+	{
+		BddSet s(vs, bdd);
+
+		for (BddSet::const_iterator i = s.begin();i != s.end();++i)
+		{
+			vals.push_back(*i);
+		}
+
+		sort(vals.begin(), vals.end());
+	}
+
+	return vals;
+}
+
+/// Convert to BDD set
+/**
+ * @return The set with the same values and domain as a gbdd::BddSet
+ */
+BddSet AdaptiveSet::get_bdd_set() const
+{
+	AdaptiveSet s(*this);
+
+	s.set_encoding(ENCODING_BDD);
+
+	return BddSet(vs, s.bdd);
+}
+
+/// Product of sets
+/**
+ * Both sets are brought to the larger of their encodings. Sorted
+ * arrays are merged, bitsets combined word by word, and BDDs with a
+ * BDD product.
+ *
+ * @param s2 Set with the same domain
+ * @param fn Product function, false for two false arguments
+ * 
+ * @return This set, containing the values v for which fn(v in this set, v in \a s2) holds
+ */
+AdaptiveSet& AdaptiveSet::product(const AdaptiveSet& s2, bool (*fn)(bool v1, bool v2))
+{
+	assert(vs == s2.vs && !fn(false, false));
+
+	if (s2.encoding != encoding)
+	{
+		AdaptiveSet s2_converted(s2);
+
+		set_encoding(max(encoding, s2.encoding));
+		s2_converted.set_encoding(encoding);
+
+		return product(s2_converted, fn);
+	}
+
+	if (encoding == ENCODING_SORTED)
+	{
+		vector<unsigned int> new_values;
+		vector<unsigned int>::const_iterator i1 = values.begin();
+		vector<unsigned int>::const_iterator i2 = s2.values.begin();
+
+		while (i1 != values.end() || i2 != s2.values.end())
+		{
+			bool in1 = i2 == s2.values.end() || (i1 != values.end() && *i1 <= *i2);
+			bool in2 = i1 == values.end() || (i2 != s2.values.end() && *i2 <= *i1);
+			unsigned int v = in1 ? *i1 : *i2;
+
+			if (fn(in1, in2)) new_values.push_back(v);
+
+			if (in1) ++i1;
+			if (in2) ++i2;
+		}
+
+		values.swap(new_values);
+	}
+	else if (encoding == ENCODING_BITSET)
+	{
+		uint64_t m11 = fn(true, true) ? ~(uint64_t)0 : 0;
+		uint64_t m10 = fn(true, false) ? ~(uint64_t)0 : 0;
+		uint64_t m01 = fn(false, true) ? ~(uint64_t)0 : 0;
+
+		for (unsigned int i = 0;i < bits.size();++i)
+		{
+			uint64_t a = bits[i];
+			uint64_t b = s2.bits[i];
+
+			bits[i] = (a & b & m11) | (a & ~b & m10) | (~a & b & m01);
+		}
+	}
+	else
+	{
+		bdd = Bdd::bdd_product(bdd, s2.bdd, fn);
+
+		// A union never shrinks a set below the limits of the BDD encoding
+		if (fn(true, false) && fn(false, true)) return *this;
+	}
+
+	adapt();
+
+	return *this;
+}
+
+AdaptiveSet& AdaptiveSet::operator|=(const AdaptiveSet& s2)
+{
+	return product(s2, StructureConstraint::fn_or);
+}
+
+AdaptiveSet& AdaptiveSet::operator&=(const AdaptiveSet& s2)
+{
+	return product(s2, StructureConstraint::fn_and);
+}
+
+AdaptiveSet& AdaptiveSet::operator-=(const AdaptiveSet& s2)
+{
+	return product(s2, StructureConstraint::fn_minus);
+}
+
+AdaptiveSet operator|(const AdaptiveSet& s1, const AdaptiveSet& s2)
+{
+	AdaptiveSet s(s1);
+
+	return s |= s2;
+}
+
+AdaptiveSet operator&(const AdaptiveSet& s1, const AdaptiveSet& s2)
+{
+	AdaptiveSet s(s1);
+
+	return s &= s2;
+}
+
+AdaptiveSet operator-(const AdaptiveSet& s1, const AdaptiveSet& s2)
+{
+	AdaptiveSet s(s1);
+
+	return s -= s2;
+}
+
+/// Test for equality
+/**
+ * @param s1 First set
+ * @param s2 Second set, with the same domain
+ * 
+ * @return Whether \a s1 and \a s2 have the same values
+ */
+bool operator==(const AdaptiveSet& s1, const AdaptiveSet& s2)
+{
+	assert(s1.vs == s2.vs);
+
+	if (s1.encoding != s2.encoding)
+	{
+		AdaptiveSet s1_converted(s1);
+		AdaptiveSet s2_converted(s2);
+
+		s1_converted.set_encoding(max(s1.encoding, s2.encoding));
+		s2_converted.set_encoding(max(s1.encoding, s2.encoding));
+
+		return s1_converted == s2_converted;
+	}
+
+	switch (s1.encoding)
+	{
+	case AdaptiveSet::ENCODING_SORTED:
+		return s1.values == s2.values;
+	case AdaptiveSet::ENCODING_BITSET:
+		return s1.bits == s2.bits;
+	default:
+		return s1.bdd == s2.bdd;
+	}
+}
+
+}
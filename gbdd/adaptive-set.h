@@ -0,0 +1,120 @@
+/*
+ * adaptive-set.h: 
+ *
+ * Copyright (C) 2004 Marcus Nilsson (marcusn@it.uu.se)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ * 
+ * Authors:
+ *    Marcus Nilsson (marcusn@it.uu.se)
+ */
+
+
+#ifndef ADAPTIVE_SET_H
+#define ADAPTIVE_SET_H
+
+#include <gbdd/bdd-relation.h>
+#include <stdint.h>
+#include <vector>
+
+namespace gbdd
+{
+	/// Set of values that picks its encoding by size
+	/**
+	 * Values are encoded in a finite domain as in gbdd::BddSet. A set
+	 * of at most max_sorted_size values is kept as a sorted array. A
+	 * larger set is kept as a bitset with one bit per value of the
+	 * domain if the domain has at most max_bitset_vars variables, and
+	 * as a BDD otherwise. The encoding is changed when a set grows
+	 * over or shrinks well below the limits, so that small sets never
+	 * touch the BDD space. Values outside the domain are never
+	 * members. Only sets over a single domain are supported.
+	 */
+	class AdaptiveSet
+	{
+	public:
+		/// Encoding of a set
+		enum Encoding
+		{
+			ENCODING_SORTED,
+			ENCODING_BITSET,
+			ENCODING_BDD
+		};
+
+		/// Maximum number of values in a sorted array
+		static const unsigned int max_sorted_size = 128;
+		/// Maximum number of variables of a domain encoded as bitset
+		static const unsigned int max_bitset_vars = 16;
+	private:
+		Space* space;
+		Domain vs;
+
+		Encoding encoding;
+		vector<unsigned int> values;
+		vector<uint64_t> bits;
+		Bdd bdd;
+
+		bool is_bitset_allowed() const;
+		unsigned int n_bitset_words() const;
+
+		void set_encoding(Encoding e);
+		void adapt();
+	public:
+		AdaptiveSet(Space* space, const Domain& vs);
+		AdaptiveSet(const BddSet& s);
+
+/// Get encoding
+/**
+ * @return The current encoding of the set
+ */
+		Encoding get_encoding() const { return encoding; }
+
+/// Get domain
+/**
+ * @return The domain values are encoded in
+ */
+		const Domain& get_domain() const { return vs; }
+
+/// Get space
+/**
+ * @return Space of BDDs of the set
+ */
+		Space* get_space() const { return space; }
+
+		bool insert(unsigned int v);
+		bool member(unsigned int v) const;
+
+		unsigned int size() const;
+		bool is_empty() const;
+
+		vector<unsigned int> get_values() const;
+		BddSet get_bdd_set() const;
+
+		AdaptiveSet& product(const AdaptiveSet& s2, bool (*fn)(bool v1, bool v2));
+
+		AdaptiveSet& operator|=(const AdaptiveSet& s2);
+		AdaptiveSet& operator&=(const AdaptiveSet& s2);
+		AdaptiveSet& operator-=(const AdaptiveSet& s2);
+
+		friend AdaptiveSet operator|(const AdaptiveSet& s1, const AdaptiveSet& s2);
+		friend AdaptiveSet operator&(const AdaptiveSet& s1, const AdaptiveSet& s2);
+		friend AdaptiveSet operator-(const AdaptiveSet& s1, const AdaptiveSet& s2);
+
+		friend bool operator==(const AdaptiveSet& s1, const AdaptiveSet& s2);
+		friend bool operator!=(const AdaptiveSet& s1, const AdaptiveSet& s2) { return !(s1 == s2); }
+	};
+}
+
+#endif /* ADAPTIVE_SET_H */
@@ -0,0 +1,260 @@
+/*
+ * add-space.cc: 
+ *
+ * Copyright (C) 2004 Marcus Nilsson (marcusn@it.uu.se)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ * 
+ * Authors:
+ *    Marcus Nilsson (marcusn@it.uu.se)
+ */
+
+
+#include <gbdd/add-space.h>
+#include <iostream>
+
+namespace gbdd
+{
+
+/// Constructor
+AddSpace::AddSpace():
+	nodes(N_OPERATIONS)
+{}
+
+/// Garbage collection
+/**
+ * Nodes are never freed, only the caches of add_apply are emptied
+ */
+void AddSpace::gc()
+{
+	nodes.clear_op_caches();
+}
+
+/// Apply operation to numbers
+/**
+ * The minimum and maximum with NaN are NaN, so that all operations are
+ * commutative also for NaN.
+ *
+ * @param op Operation
+ * @param v1 First number
+ * @param v2 Second number
+ * 
+ * @return \a op applied to \a v1 and \a v2
+ */
+double AddSpace::apply_op(Operation op, double v1, double v2)
+{
+	switch (op)
+	{
+	case OP_PLUS:
+		return v1 + v2;
+	case OP_TIMES:
+		return v1 * v2;
+	case OP_MIN:
+		return (v1 < v2 || v1 != v1) ? v1 : v2;
+	default:
+		return (v1 > v2 || v1 != v1) ? v1 : v2;
+	}
+}
+
+/// Create leaf
+/**
+ * @param v Number, all NaN values give the same leaf
+ * 
+ * @return The constant function \a v
+ */
+AddSpace::Add AddSpace::add_leaf(double v)
+{
+	map<double, Add, less_value>::iterator i = leaves.find(v);
+
+	if (i != leaves.end()) return i->second;
+
+	Add new_node = nodes.leaf(v);
+	leaves[v] = new_node;
+
+	return new_node;
+}
+
+/// Create node
+/**
+ * @param v Variable of node, lower than the variables of \a p_then and \a p_else
+ * @param p_then Function when \a v is true
+ * @param p_else Function when \a v is false
+ * 
+ * @return The ADD for if \a v then \a p_then else \a p_else
+ */
+AddSpace::Add AddSpace::add_var_then_else(Var v, Add p_then, Add p_else)
+{
+	if (p_then == p_else) return p_then;
+
+	return nodes.var_then_else(v, p_then, p_else);
+}
+
+/// Pointwise operation
+/**
+ * @param op Operation
+ * @param p First ADD
+ * @param q Second ADD
+ * 
+ * @return The function mapping an assignment to \a op applied to the values of \a p and \a q
+ */
+AddSpace::Add AddSpace::add_apply(Operation op, Add p, Add q)
+{
+	if (add_is_leaf(p) && add_is_leaf(q))
+	{
+		return add_leaf(apply_op(op, add_leaf_value(p), add_leaf_value(q)));
+	}
+
+	if ((op == OP_MIN || op == OP_MAX) && p == q) return p;
+
+	// All operations are commutative
+	if (p > q) swap(p, q);
+
+	AddPairCache& cache = nodes.op_cache(op);
+	AddPairCache::iterator i = cache.find(AddPair(p, q));
+
+	if (i != cache.end()) return i->second;
+
+	Var v =
+		add_is_leaf(p) ? add_var(q) :
+		add_is_leaf(q) ? add_var(p) :
+		min(add_var(p), add_var(q));
+
+	bool p_top = !add_is_leaf(p) && add_var(p) == v;
+	bool q_top = !add_is_leaf(q) && add_var(q) == v;
+
+	Add r = add_var_then_else(v,
+				  add_apply(op, p_top ? add_then(p) : p, q_top ? add_then(q) : q),
+				  add_apply(op, p_top ? add_else(p) : p, q_top ? add_else(q) : q));
+
+	cache[AddPair(p, q)] = r;
+
+	return r;
+}
+
+/// Abstract variables
+/**
+ * A variable not in the ADD has the same function for both values, so
+ * the function is combined with itself.
+ *
+ * @param op Operation combining the two values of each variable
+ * @param p ADD
+ * @param vs Variables to abstract, finite
+ * 
+ * @return The function of the other variables, the value of an
+ * assignment being \a op applied to the values of \a p for all values of \a vs
+ */
+AddSpace::Add AddSpace::add_abstract(Operation op, Add p, const Domain& vs)
+{
+	assert(vs.is_finite());
+
+	vector<Var> vars;
+	for (Domain::const_iterator i = vs.begin();i != vs.end();++i)
+	{
+		vars.push_back(*i);
+	}
+
+	vector<hash_map<Add, Add> > cache(vars.size());
+
+	return add_abstract(op, p, vars, 0, cache);
+}
+
+AddSpace::Add AddSpace::add_abstract(Operation op, Add p, const vector<Var>& vars, unsigned int var_i,
+				     vector<hash_map<Add, Add> >& cache)
+{
+	if (var_i == vars.size()) return p;
+
+	hash_map<Add, Add>::iterator i = cache[var_i].find(p);
+
+	if (i != cache[var_i].end()) return i->second;
+
+	Add r;
+
+	if (add_is_leaf(p) || vars[var_i] < add_var(p))
+	{
+		Add q = add_abstract(op, p, vars, var_i + 1, cache);
+
+		r = add_apply(op, q, q);
+	}
+	else if (vars[var_i] == add_var(p))
+	{
+		r = add_apply(op,
+			      add_abstract(op, add_then(p), vars, var_i + 1, cache),
+			      add_abstract(op, add_else(p), vars, var_i + 1, cache));
+	}
+	else
+	{
+		r = add_var_then_else(add_var(p),
+				      add_abstract(op, add_then(p), vars, var_i, cache),
+				      add_abstract(op, add_else(p), vars, var_i, cache));
+	}
+
+	cache[var_i][p] = r;
+
+	return r;
+}
+
+/// Count nodes
+/**
+ * @param p ADD
+ * 
+ * @return Number of nodes reachable from \a p, including leaves
+ */
+unsigned int AddSpace::add_n_nodes(Add p)
+{
+	return nodes.get_n_nodes(p);
+}
+
+/// Print ADD
+/**
+ * @param os Stream to print to
+ * @param p ADD to print
+ */
+void AddSpace::add_print(ostream &os, Add p)
+{
+	if (add_is_leaf(p))
+	{
+		os << add_leaf_value(p);
+	}
+	else
+	{
+		os << "(" << add_var(p) << " ";
+		add_print(os, add_then(p));
+		os << " ";
+		add_print(os, add_else(p));
+		os << ")";
+	}
+}
+
+/// Get number of nodes
+/**
+ * @return Number of nodes in the space, including leaves
+ */
+unsigned int AddSpace::get_n_nodes() const
+{
+	return nodes.get_n_nodes();
+}
+
+/// Print statistics
+/**
+ * @param os Stream to print to
+ */
+void AddSpace::print_statistics(ostream& os) const
+{
+	os << "Nodes: " << nodes.get_n_nodes() << endl;
+	os << "Leaves: " << leaves.size() << endl;
+	os << "Cached results: " << nodes.get_n_cached() << endl;
+}
+
+}
@@ -0,0 +1,152 @@
+/*
+ * add-space.h: 
+ *
+ * Copyright (C) 2004 Marcus Nilsson (marcusn@it.uu.se)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ * 
+ * Authors:
+ *    Marcus Nilsson (marcusn@it.uu.se)
+ */
+
+
+#ifndef GBDD_ADD_SPACE_H
+#define GBDD_ADD_SPACE_H
+
+#include <gbdd/node-table.h>
+#include <map>
+
+namespace gbdd
+{
+	/// Space of algebraic decision diagrams
+	/**
+	 * An ADD is a decision diagram with numbers as leaves, a function
+	 * from assignments to numbers. Nodes with equal branches are removed
+	 * as in a BDD. Each number has one leaf, so equal functions have
+	 * the same node. All NaN values share one leaf.
+	 *
+	 * Weighted relations are ADDs over the variables of their domains,
+	 * built and combined with the pointwise operations and abstracted
+	 * with add_abstract, as relations in a gbdd::Space are with AND, OR
+	 * and projection.
+	 */
+	class AddSpace
+	{
+	public:
+		typedef Space::Var Var;
+		typedef NodeTable<double>::Node Add;
+
+		/// Pointwise operations
+		enum Operation
+		{
+			OP_PLUS,
+			OP_TIMES,
+			OP_MIN,
+			OP_MAX,
+			N_OPERATIONS
+		};
+	private:
+		typedef NodeTable<double>::NodePair AddPair;
+		typedef NodeTable<double>::NodePairCache AddPairCache;
+
+		/// Order of leaf values, with NaN before all numbers
+		struct less_value
+		{
+			bool operator()(double v1, double v2) const
+			{
+				return (v1 != v1) ? (v2 == v2) : (v1 < v2);
+			}
+		};
+
+		NodeTable<double> nodes;
+		map<double, Add, less_value> leaves;
+
+		static double apply_op(Operation op, double v1, double v2);
+
+		Add add_abstract(Operation op, Add p, const vector<Var>& vars, unsigned int var_i,
+				 vector<hash_map<Add, Add> >& cache);
+	public:
+		AddSpace();
+
+		void gc();
+
+/// Test for leaf
+/**
+ * @param p ADD
+ *
+ * @return Whether \a p is a leaf
+ */
+		bool add_is_leaf(Add p) const { return nodes.is_leaf(p); }
+
+/// Value of leaf
+/**
+ * @param p Leaf
+ *
+ * @return The number of \a p
+ */
+		double add_leaf_value(Add p) const
+		{
+			return nodes.get_value(p);
+		}
+
+/// Get then-branch
+/**
+ * @param p Node, not a leaf
+ *
+ * @return The function when the variable of \a p is true
+ */
+		Add add_then(Add p) const
+		{
+			return nodes.get_then(p);
+		}
+
+/// Get else-branch
+/**
+ * @param p Node, not a leaf
+ *
+ * @return The function when the variable of \a p is false
+ */
+		Add add_else(Add p) const
+		{
+			return nodes.get_else(p);
+		}
+
+/// Get variable
+/**
+ * @param p Node, not a leaf
+ *
+ * @return Variable of \a p
+ */
+		Var add_var(Add p) const
+		{
+			return nodes.get_var(p);
+		}
+
+		Add add_leaf(double v);
+		Add add_var_then_else(Var v, Add p_then, Add p_else);
+
+		Add add_apply(Operation op, Add p, Add q);
+		Add add_abstract(Operation op, Add p, const Domain& vs);
+
+		unsigned int add_n_nodes(Add p);
+
+		void add_print(ostream &os, Add p);
+
+		unsigned int get_n_nodes() const;
+		void print_statistics(ostream& os) const;
+	};
+}
+
+#endif /* GBDD_ADD_SPACE_H */
@@ -0,0 +1,255 @@
+/*
+ * add.cc: 
+ *
+ * Copyright (C) 2004 Marcus Nilsson (marcusn@it.uu.se)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ * 
+ * Authors:
+ *    Marcus Nilsson (marcusn@it.uu.se)
+ */
+
+
+#include <gbdd/add.h>
+
+namespace gbdd
+{
+
+/// Constant function
+/**
+ * @param space Space of returned ADD
+ * @param v Number
+ * 
+ * @return The ADD with value \a v for all assignments
+ */
+Add Add::constant(AddSpace* space, double v)
+{
+	return Add(space, space->add_leaf(v));
+}
+
+AddSpace::Add Add::from_bdd(AddSpace* space, const Bdd& p_bdd, AddSpace::Add a_true,
+			    AddSpace::Add a_false, hash_map<Bdd, AddSpace::Add>& cache)
+{
+	if (p_bdd.bdd_is_leaf()) return p_bdd.bdd_leaf_value() ? a_true : a_false;
+
+	hash_map<Bdd, AddSpace::Add>::iterator i = cache.find(p_bdd);
+
+	if (i != cache.end()) return i->second;
+
+	AddSpace::Add r = space->add_var_then_else(p_bdd.bdd_var(),
+						   from_bdd(space, p_bdd.bdd_then(), a_true, a_false, cache),
+						   from_bdd(space, p_bdd.bdd_else(), a_true, a_false, cache));
+
+	cache[p_bdd] = r;
+
+	return r;
+}
+
+/// Convert BDD to ADD
+/**
+ * @param space Space of returned ADD
+ * @param p BDD
+ * @param v_true Value of assignments in \a p
+ * @param v_false Value of other assignments
+ * 
+ * @return The ADD with value \a v_true where \a p is true and \a v_false elsewhere
+ */
+Add Add::from_bdd(AddSpace* space, const Bdd& p, double v_true, double v_false)
+{
+	hash_map<Bdd, AddSpace::Add> cache;
+
+	return Add(space, from_bdd(space, p, space->add_leaf(v_true), space->add_leaf(v_false), cache));
+}
+
+Bdd Add::threshold(Space* bdd_space, double t, AddSpace::Add q,
+		   hash_map<AddSpace::Add, Bdd>& cache) const
+{
+	if (space->add_is_leaf(q)) return Bdd(bdd_space, space->add_leaf_value(q) >= t);
+
+	hash_map<AddSpace::Add, Bdd>::iterator i = cache.find(q);
+
+	if (i != cache.end()) return i->second;
+
+	Bdd r = Bdd::var_then_else(bdd_space, space->add_var(q),
+				   threshold(bdd_space, t, space->add_then(q), cache),
+				   threshold(bdd_space, t, space->add_else(q), cache));
+
+	cache[q] = r;
+
+	return r;
+}
+
+/// Convert to BDD by threshold
+/**
+ * @param bdd_space Space of returned BDD
+ * @param t Threshold
+ * 
+ * @return The BDD true for the assignments with value at least \a t
+ */
+Bdd Add::threshold(Space* bdd_space, double t) const
+{
+	hash_map<AddSpace::Add, Bdd> cache;
+
+	return threshold(bdd_space, t, p, cache);
+}
+
+bool Add::add_is_leaf() const
+{
+	return space->add_is_leaf(p);
+}
+
+double Add::add_leaf_value() const
+{
+	return space->add_leaf_value(p);
+}
+
+Add::Var Add::add_var() const
+{
+	return space->add_var(p);
+}
+
+Add Add::add_then() const
+{
+	return Add(space, space->add_then(p));
+}
+
+Add Add::add_else() const
+{
+	return Add(space, space->add_else(p));
+}
+
+/// Pointwise operation
+/**
+ * @param p2 Second ADD
+ * @param op Operation
+ * 
+ * @return The function applying \a op to the values of this ADD and \a p2
+ */
+Add Add::apply(const Add& p2, AddSpace::Operation op) const
+{
+	assert(space == p2.space);
+
+	return Add(space, space->add_apply(op, p, p2.p));
+}
+
+Add Add::operator+(const Add& p2) const
+{
+	return apply(p2, AddSpace::OP_PLUS);
+}
+
+Add Add::operator*(const Add& p2) const
+{
+	return apply(p2, AddSpace::OP_TIMES);
+}
+
+Add& Add::operator+=(const Add& p2)
+{
+	return *this = *this + p2;
+}
+
+Add& Add::operator*=(const Add& p2)
+{
+	return *this = *this * p2;
+}
+
+/// Pointwise minimum
+/**
+ * @param p1 First ADD
+ * @param p2 Second ADD
+ * 
+ * @return The function taking the minimum of the values of \a p1 and \a p2
+ */
+Add Add::min(const Add& p1, const Add& p2)
+{
+	return p1.apply(p2, AddSpace::OP_MIN);
+}
+
+/// Pointwise maximum
+/**
+ * @param p1 First ADD
+ * @param p2 Second ADD
+ * 
+ * @return The function taking the maximum of the values of \a p1 and \a p2
+ */
+Add Add::max(const Add& p1, const Add& p2)
+{
+	return p1.apply(p2, AddSpace::OP_MAX);
+}
+
+/// Abstract variables
+/**
+ * @param vs Variables to abstract, finite
+ * @param op Operation combining the values for the two values of each variable
+ * 
+ * @return The function of the other variables combining the values over all values of \a vs
+ */
+Add Add::abstract(const Domain& vs, AddSpace::Operation op) const
+{
+	return Add(space, space->add_abstract(op, p, vs));
+}
+
+/// Evaluate
+/**
+ * Variables not in \a vs are taken to be false
+ *
+ * @param vs Variables to encode value in
+ * @param v Value to encode
+ * 
+ * @return The value of the assignment encoding \a v in \a vs
+ */
+double Add::evaluate(const Domain& vs, unsigned int v) const
+{
+	AddSpace::Add q = p;
+
+	while (!space->add_is_leaf(q))
+	{
+		bool value = false;
+		unsigned int bit = 0;
+
+		for (Domain::const_iterator i = vs.begin();i != vs.end() && *i <= space->add_var(q);++i, ++bit)
+		{
+			value = *i == space->add_var(q) && ((v >> bit) & 0x1);
+		}
+
+		q = value ? space->add_then(q) : space->add_else(q);
+	}
+
+	return space->add_leaf_value(q);
+}
+
+/// Get number of nodes
+/**
+ * @return Number of nodes of this ADD, including leaves
+ */
+unsigned int Add::get_n_nodes() const
+{
+	return space->add_n_nodes(p);
+}
+
+bool operator==(const Add& p1, const Add& p2)
+{
+	assert(p1.space == p2.space);
+
+	return p1.p == p2.p;
+}
+
+ostream& operator<<(ostream& os, const Add& p)
+{
+	p.space->add_print(os, p.p);
+
+	return os;
+}
+
+}
@@ -0,0 +1,123 @@
+/*
+ * add.h: 
+ *
+ * Copyright (C) 2004 Marcus Nilsson (marcusn@it.uu.se)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ * 
+ * Authors:
+ *    Marcus Nilsson (marcusn@it.uu.se)
+ */
+
+
+#ifndef GBDD_ADD_H
+#define GBDD_ADD_H
+
+#include <gbdd/add-space.h>
+#include <gbdd/bdd.h>
+
+namespace gbdd
+{
+	/// Function from assignments to numbers as an algebraic decision diagram
+	/**
+	 * An Add attaches a number, such as a count, a cost or a
+	 * probability, to each assignment. A relation with weights on its
+	 * tuples is an Add over the variables of its domains. For example,
+	 * to count the tuples of a binary relation per value of its first
+	 * domain, the relation is converted with from_bdd() and the second
+	 * domain is abstracted with sum(). A threshold gives back a gbdd::Bdd.
+	 */
+	class Add
+	{
+		AddSpace* space;
+		AddSpace::Add p;
+
+		static AddSpace::Add from_bdd(AddSpace* space, const Bdd& p_bdd, AddSpace::Add a_true,
+					      AddSpace::Add a_false, hash_map<Bdd, AddSpace::Add>& cache);
+		Bdd threshold(Space* bdd_space, double t, AddSpace::Add q,
+			      hash_map<AddSpace::Add, Bdd>& cache) const;
+	public:
+		typedef Domain::Var Var;
+
+/// Create ADD from node
+/**
+ * @param space Space of \a p
+ * @param p Node
+ */
+		Add(AddSpace* space, AddSpace::Add p) : space(space), p(p) {}
+
+		static Add constant(AddSpace* space, double v);
+		static Add from_bdd(AddSpace* space, const Bdd& p, double v_true = 1, double v_false = 0);
+
+		Bdd threshold(Space* bdd_space, double t) const;
+
+/// Get space
+/**
+ * @return The space of this ADD
+ */
+		AddSpace* get_space() const { return space; }
+
+/// Get node
+/**
+ * @return The node of this ADD in its space
+ */
+		AddSpace::Add get_add() const { return p; }
+
+		bool add_is_leaf() const;
+		double add_leaf_value() const;
+		Var add_var() const;
+		Add add_then() const;
+		Add add_else() const;
+
+		Add apply(const Add& p2, AddSpace::Operation op) const;
+
+		Add operator+(const Add& p2) const;
+		Add operator*(const Add& p2) const;
+
+		Add& operator+=(const Add& p2);
+		Add& operator*=(const Add& p2);
+
+		static Add min(const Add& p1, const Add& p2);
+		static Add max(const Add& p1, const Add& p2);
+
+		Add abstract(const Domain& vs, AddSpace::Operation op) const;
+
+/// Sum abstraction
+/**
+ * @param vs Variables to abstract, finite
+ * 
+ * @return The function of the other variables summing the values over all values of \a vs
+ */
+		Add sum(const Domain& vs) const { return abstract(vs, AddSpace::OP_PLUS); }
+
+/// Maximum abstraction
+/**
+ * @param vs Variables to abstract, finite
+ * 
+ * @return The function of the other variables taking the maximum over all values of \a vs
+ */
+		Add maximum(const Domain& vs) const { return abstract(vs, AddSpace::OP_MAX); }
+
+		double evaluate(const Domain& vs, unsigned int v) const;
+
+		unsigned int get_n_nodes() const;
+
+		friend bool operator==(const Add& p1, const Add& p2);
+		friend bool operator!=(const Add& p1, const Add& p2) { return !(p1 == p2); }
+		friend ostream& operator<<(ostream& os, const Add& p);
+	};
+}
+
+#endif /* GBDD_ADD_H */
@@ -0,0 +1,216 @@
+/*
+ * bdd-batch-evaluator.cc: 
+ *
+ * Copyright (C) 2004 Marcus Nilsson (marcusn@it.uu.se)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ * 
+ * Authors:
+ *    Marcus Nilsson (marcusn@it.uu.se)
+ */
+
+
+#include <gbdd/bdd-batch-evaluator.h>
+#include <string.h>
+
+namespace gbdd
+{
+
+/// Copy node and its descendants
+/**
+ * Nodes are numbered after their children
+ *
+ * @param p BDD to copy
+ * @param columns Column of each variable
+ * @param ids Index of nodes copied so far
+ * 
+ * @return Index of \a p
+ */
+uint32_t BddBatchEvaluator::add_node(const Bdd& p, const hash_map<Domain::Var, uint32_t>& columns,
+				     hash_map<Bdd, uint32_t>& ids)
+{
+	if (p.bdd_is_leaf()) return p.bdd_leaf_value() ? 1 : 0;
+
+	hash_map<Bdd, uint32_t>::const_iterator i = ids.find(p);
+
+	if (i != ids.end()) return i->second;
+
+	hash_map<Domain::Var, uint32_t>::const_iterator column = columns.find(p.bdd_var());
+
+	assert(column != columns.end());
+
+	Node node;
+
+	node.column = column->second;
+	node.then_node = add_node(p.bdd_then(), columns, ids);
+	node.else_node = add_node(p.bdd_else(), columns, ids);
+
+	uint32_t id = nodes.size();
+
+	ids[p] = id;
+	nodes.push_back(node);
+
+	return id;
+}
+
+/// Constructor
+/**
+ * @param ds Domains of the tuples
+ * @param p BDD over \a ds
+ */
+BddBatchEvaluator::BddBatchEvaluator(const Domains& ds, const Bdd& p):
+	nodes(2),
+	domains(ds.size()),
+	n_columns(0)
+{
+	hash_map<Domain::Var, uint32_t> columns;
+
+	for (unsigned int i = 0;i < ds.size();++i)
+	{
+		domains[i] = ds[i].is_infinite() ? ds[i].first_n(32) : ds[i];
+
+		assert(domains[i].size() <= 32);
+
+		first_column.push_back(n_columns);
+
+		for (Domain::const_iterator j = domains[i].begin();j != domains[i].end();++j)
+		{
+			assert(columns.find(*j) == columns.end());
+
+			columns[*j] = n_columns++;
+		}
+	}
+
+	hash_map<Bdd, uint32_t> ids;
+
+	if (add_node(p, columns, ids) < 2)
+	{
+		// Keep a leaf as the last node, which is where evaluation starts
+
+		nodes.resize(p.bdd_leaf_value() ? 2 : 1);
+	}
+}
+
+/// Evaluate block
+/**
+ * @param columns The masks of the block for each column, column c starting at word c * block_words
+ * @param reach Scratch space for masks of each node, of get_n_nodes() * block_words words
+ * @param result The mask of tuples in the block for which the BDD is true, block_words words
+ */
+void BddBatchEvaluator::evaluate_block(const Word* columns, Word* reach, Word* result) const
+{
+	uint32_t root = nodes.size() - 1;
+
+	memset(reach, 0, nodes.size() * block_words * sizeof(Word));
+
+	for (unsigned int w = 0;w < block_words;++w)
+	{
+		reach[root * block_words + w] = ~(Word)0;
+	}
+
+	// Parents come after their children, so a node has all its masks when it is reached
+
+	for (uint32_t node = root;node >= 2;--node)
+	{
+		Word* node_reach = reach + node * block_words;
+		Word any = 0;
+
+		for (unsigned int w = 0;w < block_words;++w)
+		{
+			any |= node_reach[w];
+		}
+
+		if (any == 0) continue;
+
+		const Word* column = columns + nodes[node].column * block_words;
+		Word* then_reach = reach + nodes[node].then_node * block_words;
+		Word* else_reach = reach + nodes[node].else_node * block_words;
+
+		for (unsigned int w = 0;w < block_words;++w)
+		{
+			then_reach[w] |= node_reach[w] & column[w];
+			else_reach[w] |= node_reach[w] & ~column[w];
+		}
+	}
+
+	for (unsigned int w = 0;w < block_words;++w)
+	{
+		result[w] = (root == 0) ? 0 : reach[block_words + w];
+	}
+}
+
+/// Evaluate tuples
+/**
+ * @param values Values of the tuples in column-major order, values[i][k] is the value of domain i in tuple k
+ * 
+ * @return For each tuple, whether the BDD is true for its values, false if some value is too large for its domain
+ */
+vector<bool> BddBatchEvaluator::evaluate(const vector<vector<unsigned int> >& values) const
+{
+	assert(values.size() == domains.size());
+
+	unsigned int n_tuples = values.empty() ? 0 : values[0].size();
+	vector<bool> res(n_tuples);
+
+	vector<Word> columns(n_columns * block_words + 1);
+	vector<Word> reach(nodes.size() * block_words);
+	Word result[block_words];
+	Word valid[block_words];
+
+	for (unsigned int first = 0;first < n_tuples;first += block_size)
+	{
+		unsigned int n_block = n_tuples - first;
+
+		if (n_block > block_size) n_block = block_size;
+
+		fill(columns.begin(), columns.end(), 0);
+		fill(valid, valid + block_words, ~(Word)0);
+
+		// Transpose the block into one column of bits per variable
+
+		for (unsigned int i = 0;i < values.size();++i)
+		{
+			assert(values[i].size() == n_tuples);
+
+			unsigned int n_bits = domains[i].size();
+			Word* domain_columns = &columns[first_column[i] * block_words];
+
+			for (unsigned int k = 0;k < n_block;++k)
+			{
+				unsigned int v = values[i][first + k];
+				Word bit = (Word)1 << (k & 0x3f);
+				unsigned int w = k >> 6;
+
+				if (n_bits < 32 && (v >> n_bits) != 0) valid[w] &= ~bit;
+
+				for (unsigned int j = 0;v != 0 && j < n_bits;++j, v >>= 1)
+				{
+					if (v & 0x01) domain_columns[j * block_words + w] |= bit;
+				}
+			}
+		}
+
+		evaluate_block(&columns[0], &reach[0], result);
+
+		for (unsigned int k = 0;k < n_block;++k)
+		{
+			res[first + k] = (result[k >> 6] & valid[k >> 6] & ((Word)1 << (k & 0x3f))) != 0;
+		}
+	}
+
+	return res;
+}
+
+}
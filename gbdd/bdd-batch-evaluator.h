@@ -0,0 +1,98 @@
+/*
+ * bdd-batch-evaluator.h: 
+ *
+ * Copyright (C) 2004 Marcus Nilsson (marcusn@it.uu.se)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ * 
+ * Authors:
+ *    Marcus Nilsson (marcusn@it.uu.se)
+ */
+
+
+#ifndef BDD_BATCH_EVALUATOR_H
+#define BDD_BATCH_EVALUATOR_H
+
+#include <gbdd/bdd.h>
+#include <stdint.h>
+#include <vector>
+
+namespace gbdd
+{
+	/// Evaluates a BDD for many tuples at once
+	/**
+	 * Tuples are evaluated in blocks of gbdd::BddBatchEvaluator::block_size.
+	 * A block is given bit-sliced, as one column of bits for each
+	 * variable, so each node is visited once per block. The set of tuples
+	 * reaching a node is a bit mask, split by the column of the node
+	 * variable into the masks passed to its children. The masks of a
+	 * block are a few words, which the compiler can keep in vector
+	 * registers.
+	 *
+	 * The variables of each domain are the bits of its values, least
+	 * significant bit first. Infinite domains are cut to their first 32
+	 * variables, and all variables of the BDD must be in the domains.
+	 */
+	class BddBatchEvaluator
+	{
+	public:
+		typedef uint64_t Word;
+
+		/// Number of words in masks of a block
+		static const unsigned int block_words = 4;
+
+		/// Number of tuples in a block
+		static const unsigned int block_size = block_words * 64;
+	private:
+		class Node
+		{
+		public:
+			/// Column of variable
+			uint32_t column;
+			uint32_t then_node;
+			uint32_t else_node;
+		};
+
+		/// Nodes, children before parents, after the false and true leaves
+		vector<Node> nodes;
+
+		Domains domains;
+		vector<unsigned int> first_column;
+		unsigned int n_columns;
+
+		uint32_t add_node(const Bdd& p, const hash_map<Domain::Var, uint32_t>& columns,
+				  hash_map<Bdd, uint32_t>& ids);
+	public:
+		BddBatchEvaluator(const Domains& ds, const Bdd& p);
+
+/// Get number of nodes
+/**
+ * @return Number of nodes, including the leaves
+ */
+		unsigned int get_n_nodes() const { return nodes.size(); }
+
+/// Get number of columns
+/**
+ * @return Number of columns, i.e. variables, in a block
+ */
+		unsigned int get_n_columns() const { return n_columns; }
+
+		void evaluate_block(const Word* columns, Word* reach, Word* result) const;
+
+		vector<bool> evaluate(const vector<vector<unsigned int> >& values) const;
+	};
+}
+
+#endif /* BDD_BATCH_EVALUATOR_H */
@@ -198,7 +198,7 @@ BddEquivalenceRelation::quotient(const BddSet& s) const
 		hash_set<Bdd>::iterator i = found_sets.begin();
 		while (i != found_sets.end())
 		{
-			if (!((*i & bdd_s).is_false()))
+			if (i->intersects(bdd_s))
 			res.push_back(BddSet(dom_found_sets, *i & bdd_s));
 			
 			++i;
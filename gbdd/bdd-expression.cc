@@ -0,0 +1,542 @@
+/*
+ * bdd-expression.cc: 
+ *
+ * Copyright (C) 2004 Marcus Nilsson (marcusn@it.uu.se)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ * 
+ * Authors:
+ *    Marcus Nilsson (marcusn@it.uu.se)
+ */
+
+#include <gbdd/bdd-expression.h>
+#include <sstream>
+#include <assert.h>
+
+namespace gbdd
+{
+
+const BddExpressionGraph::Node BddExpressionGraph::no_node = (BddExpressionGraph::Node)-1;
+
+/// Constructor for empty graph
+BddExpressionGraph::BddExpressionGraph():
+	n_evaluated(0)
+{}
+
+/// Get number of nodes
+/**
+ * @return The number of nodes in the graph, including rewritten ones
+ */
+unsigned int BddExpressionGraph::n_nodes() const
+{
+	return nodes.size();
+}
+
+/// Get number of evaluations
+/**
+ * @return The number of operations carried out on relations since the graph was created
+ */
+unsigned int BddExpressionGraph::n_evaluations() const
+{
+	return n_evaluated;
+}
+
+/// Forget results of evaluated nodes
+void BddExpressionGraph::clear_results()
+{
+	results.clear();
+}
+
+/// Store relation
+/**
+ * @param r Relation
+ * 
+ * @return Index of \a r among the stored relations
+ */
+unsigned int BddExpressionGraph::add_value(const BddRelation& r)
+{
+	for (unsigned int i = 0;i < values.size();++i)
+	{
+		if (values[i].get_domains() == r.get_domains() &&
+		    values[i].get_bdd() == r.get_bdd())
+		{
+			return i;
+		}
+	}
+
+	values.push_back(r);
+
+	return values.size() - 1;
+}
+
+/// Store domains
+/**
+ * @param ds Domains
+ * 
+ * @return Index of \a ds among the stored domains
+ */
+unsigned int BddExpressionGraph::add_domains(const Domains& ds)
+{
+	for (unsigned int i = 0;i < renamed_domains.size();++i)
+	{
+		if (renamed_domains[i] == ds) return i;
+	}
+
+	renamed_domains.push_back(ds);
+
+	return renamed_domains.size() - 1;
+}
+
+/// Add node unless an equal node exists
+/**
+ * @param info Node to add
+ * 
+ * @return The node equal to \a info
+ */
+BddExpressionGraph::Node BddExpressionGraph::add(const NodeInfo& info)
+{
+	ostringstream key;
+
+	key << info.kind << " " << info.a << " " << info.b << " " << info.domain_index << " " << info.value;
+
+	for (vector<unsigned int>::const_iterator i = info.columns.begin();i != info.columns.end();++i)
+	{
+		key << " " << *i;
+	}
+
+	map<string, Node>::const_iterator found = unique.find(key.str());
+
+	if (found != unique.end()) return found->second;
+
+	nodes.push_back(info);
+	optimized.push_back(no_node);
+
+	Node n = nodes.size() - 1;
+	unique[key.str()] = n;
+
+	return n;
+}
+
+BddExpressionGraph::Node BddExpressionGraph::make_product(Kind kind, Node a, Node b)
+{
+	NodeInfo info;
+
+	info.kind = kind;
+	info.a = a;
+	info.b = (kind == NOT) ? no_node : b;
+	info.domain_index = 0;
+	info.value = 0;
+	info.domains = (kind == NOT) ? nodes[a].domains : Domains::sup(nodes[a].domains, nodes[b].domains);
+
+	return add(info);
+}
+
+BddExpressionGraph::Node BddExpressionGraph::make_restrict(Node a, unsigned int domain_index, unsigned int value)
+{
+	NodeInfo info;
+
+	assert(domain_index < nodes[a].domains.size());
+
+	info.kind = RESTRICT;
+	info.a = a;
+	info.b = no_node;
+	info.domain_index = domain_index;
+	info.value = value;
+	info.domains = nodes[a].domains;
+
+	return add(info);
+}
+
+BddExpressionGraph::Node BddExpressionGraph::make_project_columns(Node a, const vector<unsigned int>& columns)
+{
+	NodeInfo info;
+
+	info.kind = PROJECT_COLUMNS;
+	info.a = a;
+	info.b = no_node;
+	info.domain_index = 0;
+	info.value = 0;
+	info.columns = columns;
+	info.domains = Domains(columns.size());
+
+	for (unsigned int i = 0;i < columns.size();++i)
+	{
+		assert(columns[i] < nodes[a].domains.size());
+
+		info.domains[i] = nodes[a].domains[columns[i]];
+	}
+
+	return add(info);
+}
+
+BddExpressionGraph::Node BddExpressionGraph::make_and_project(Node a, Node b, const vector<unsigned int>& columns)
+{
+	NodeInfo info;
+	Domains ds = Domains::sup(nodes[a].domains, nodes[b].domains);
+
+	info.kind = AND_PROJECT;
+	info.a = a;
+	info.b = b;
+	info.domain_index = 0;
+	info.value = 0;
+	info.columns = columns;
+	info.domains = Domains(columns.size());
+
+	for (unsigned int i = 0;i < columns.size();++i)
+	{
+		info.domains[i] = ds[columns[i]];
+	}
+
+	return add(info);
+}
+
+BddExpressionGraph::Node BddExpressionGraph::make_rename(Node a, const Domains& ds)
+{
+	NodeInfo info;
+
+	assert(ds.size() == nodes[a].domains.size());
+
+	info.kind = RENAME;
+	info.a = a;
+	info.b = no_node;
+	info.domain_index = 0;
+	info.value = add_domains(ds);
+	info.domains = ds;
+
+	return add(info);
+}
+
+/// Push restriction towards leaves
+/**
+ * @param n Optimized node to restrict
+ * @param domain_index Component to restrict
+ * @param value Index of set to restrict to
+ * 
+ * @return An optimized node equivalent to \a n restricted in component \a domain_index
+ */
+BddExpressionGraph::Node BddExpressionGraph::push_restrict(Node n, unsigned int domain_index, unsigned int value)
+{
+	NodeInfo info = nodes[n];
+
+	switch (info.kind)
+	{
+	case AND:
+		return make_product(AND, push_restrict(info.a, domain_index, value), info.b);
+	case OR:
+		return make_product(OR, push_restrict(info.a, domain_index, value), push_restrict(info.b, domain_index, value));
+	case MINUS:
+		return make_product(MINUS, push_restrict(info.a, domain_index, value), info.b);
+	case PROJECT_COLUMNS:
+		return make_project_columns(push_restrict(info.a, info.columns[domain_index], value), info.columns);
+	case AND_PROJECT:
+		return make_and_project(push_restrict(info.a, info.columns[domain_index], value), info.b, info.columns);
+	case RENAME:
+		return make_rename(push_restrict(info.a, domain_index, value), info.domains);
+	default:
+		return make_restrict(n, domain_index, value);
+	}
+}
+
+/// Rewrite expression
+/**
+ * @param n Node to rewrite
+ * 
+ * @return A node equivalent to \a n with restrictions pushed down and fused operations
+ */
+BddExpressionGraph::Node BddExpressionGraph::optimize(Node n)
+{
+	if (optimized[n] != no_node) return optimized[n];
+
+	NodeInfo info = nodes[n];
+	Node res = n;
+
+	switch (info.kind)
+	{
+	case LEAF:
+		break;
+	case AND:
+	case OR:
+	case MINUS:
+		res = make_product(info.kind, optimize(info.a), optimize(info.b));
+		break;
+	case NOT:
+		res = make_product(NOT, optimize(info.a), no_node);
+		break;
+	case RESTRICT:
+		res = push_restrict(optimize(info.a), info.domain_index, info.value);
+		break;
+	case PROJECT_COLUMNS:
+	{
+		Node a = optimize(info.a);
+		vector<unsigned int> columns = info.columns;
+
+		if (nodes[a].kind == PROJECT_COLUMNS)
+		{
+			for (unsigned int i = 0;i < columns.size();++i)
+			{
+				columns[i] = nodes[a].columns[columns[i]];
+			}
+
+			a = nodes[a].a;
+		}
+
+		bool identity = (columns.size() == nodes[a].domains.size());
+
+		for (unsigned int i = 0;identity && i < columns.size();++i)
+		{
+			identity = (columns[i] == i);
+		}
+
+		if (identity)
+		{
+			res = a;
+		}
+		else if (nodes[a].kind == AND)
+		{
+			res = make_and_project(nodes[a].a, nodes[a].b, columns);
+		}
+		else
+		{
+			res = make_project_columns(a, columns);
+		}
+		break;
+	}
+	case AND_PROJECT:
+		res = make_and_project(optimize(info.a), optimize(info.b), info.columns);
+		break;
+	case RENAME:
+	{
+		Node a = optimize(info.a);
+
+		if (nodes[a].kind == RENAME) a = nodes[a].a;
+
+		res = (nodes[a].domains == info.domains) ? a : make_rename(a, info.domains);
+		break;
+	}
+	}
+
+	optimized[n] = res;
+	optimized[res] = res;
+
+	return res;
+}
+
+/// Evaluate node
+/**
+ * @param n Optimized node
+ * 
+ * @return The relation of \a n
+ */
+const BddRelation& BddExpressionGraph::eval(Node n)
+{
+	hash_map<Node, BddRelation>::const_iterator found = results.find(n);
+
+	if (found != results.end()) return found->second;
+
+	NodeInfo info = nodes[n];
+	BddRelation res;
+
+	switch (info.kind)
+	{
+	case LEAF:
+		res = values[info.value];
+		break;
+	case AND:
+		res = eval(info.a) & eval(info.b);
+		break;
+	case OR:
+		res = eval(info.a) | eval(info.b);
+		break;
+	case MINUS:
+		res = eval(info.a) - eval(info.b);
+		break;
+	case NOT:
+		res = !eval(info.a);
+		break;
+	case RESTRICT:
+		res = eval(info.a).restrict(info.domain_index, BddSet(values[info.value]));
+		break;
+	case PROJECT_COLUMNS:
+		res = eval(info.a).project_columns(info.columns);
+		break;
+	case AND_PROJECT:
+	{
+		Domains ds = Domains::sup(nodes[info.a].domains, nodes[info.b].domains);
+
+		if (ds.is_some_infinite())
+		{
+			res = (eval(info.a) & eval(info.b)).project_columns(info.columns);
+			break;
+		}
+
+		vector<bool> keep(ds.size(), false);
+
+		for (unsigned int i = 0;i < info.columns.size();++i)
+		{
+			keep[info.columns[i]] = true;
+		}
+
+		Domain dom_project;
+
+		for (unsigned int i = 0;i < ds.size();++i)
+		{
+			if (!keep[i]) dom_project |= ds[i];
+		}
+
+		BddRelation a(ds, eval(info.a));
+		BddRelation b(ds, eval(info.b));
+
+		res = BddRelation(info.domains, Bdd::and_project(a.get_bdd(), b.get_bdd(), dom_project));
+		break;
+	}
+	case RENAME:
+		res = BddRelation(info.domains, eval(info.a));
+		break;
+	}
+
+	if (info.kind != LEAF) n_evaluated++;
+
+	return results[n] = res;
+}
+
+/// Create expression of relation
+/**
+ * @param r Relation
+ * 
+ * @return An expression evaluating to \a r
+ */
+BddExpression BddExpressionGraph::leaf(const BddRelation& r)
+{
+	NodeInfo info;
+
+	info.kind = LEAF;
+	info.a = no_node;
+	info.b = no_node;
+	info.domain_index = 0;
+	info.value = add_value(r);
+	info.domains = r.get_domains();
+
+	return BddExpression(this, add(info));
+}
+
+BddExpression::BddExpression(BddExpressionGraph* graph, BddExpressionGraph::Node node):
+	graph(graph),
+	node(node)
+{}
+
+/// AND product
+/**
+ * @param e2 Second expression, in the same graph
+ * 
+ * @return Expression for the intersection of this expression and \a e2
+ */
+BddExpression BddExpression::operator&(const BddExpression& e2) const
+{
+	assert(graph == e2.graph);
+
+	return BddExpression(graph, graph->make_product(BddExpressionGraph::AND, node, e2.node));
+}
+
+/// OR product
+/**
+ * @param e2 Second expression, in the same graph
+ * 
+ * @return Expression for the union of this expression and \a e2
+ */
+BddExpression BddExpression::operator|(const BddExpression& e2) const
+{
+	assert(graph == e2.graph);
+
+	return BddExpression(graph, graph->make_product(BddExpressionGraph::OR, node, e2.node));
+}
+
+/// MINUS product
+/**
+ * @param e2 Second expression, in the same graph
+ * 
+ * @return Expression for this expression minus \a e2
+ */
+BddExpression BddExpression::operator-(const BddExpression& e2) const
+{
+	assert(graph == e2.graph);
+
+	return BddExpression(graph, graph->make_product(BddExpressionGraph::MINUS, node, e2.node));
+}
+
+/// Negation
+/**
+ * @return Expression for the negation of this expression
+ */
+BddExpression BddExpression::operator!() const
+{
+	return BddExpression(graph, graph->make_product(BddExpressionGraph::NOT, node, BddExpressionGraph::no_node));
+}
+
+/// Restriction
+/**
+ * @param domain_index Component to restrict
+ * @param s Set to restrict to
+ * 
+ * @return Expression for the elements of this expression with component \a domain_index in \a s
+ */
+BddExpression BddExpression::restrict(unsigned int domain_index, const BddSet& s) const
+{
+	return BddExpression(graph, graph->make_restrict(node, domain_index, graph->add_value(s)));
+}
+
+/// Projection on several components
+/**
+ * @param domain_indices Components to keep, in the order of the result
+ * 
+ * @return Expression for the relation of components \a domain_indices of this expression
+ */
+BddExpression BddExpression::project_columns(const vector<unsigned int>& domain_indices) const
+{
+	return BddExpression(graph, graph->make_project_columns(node, domain_indices));
+}
+
+/// Change domains
+/**
+ * @param ds New domains
+ * 
+ * @return Expression for this expression with domains \a ds
+ */
+BddExpression BddExpression::adapt(const Domains& ds) const
+{
+	return BddExpression(graph, graph->make_rename(node, ds));
+}
+
+/// Get domains
+/**
+ * @return The domains of the relation this expression evaluates to
+ */
+const Domains& BddExpression::get_domains() const
+{
+	return graph->nodes[node].domains;
+}
+
+/// Evaluate expression
+/**
+ * The expression is rewritten before it is evaluated, and results of
+ * subexpressions already evaluated in the graph are reused.
+ *
+ * @return The relation of this expression
+ */
+BddRelation BddExpression::evaluate() const
+{
+	return graph->eval(graph->optimize(node));
+}
+
+}
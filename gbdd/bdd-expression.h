@@ -0,0 +1,157 @@
+/*
+ * bdd-expression.h: 
+ *
+ * Copyright (C) 2004 Marcus Nilsson (marcusn@it.uu.se)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ * 
+ * Authors:
+ *    Marcus Nilsson (marcusn@it.uu.se)
+ */
+
+#ifndef BDD_EXPRESSION_H
+#define BDD_EXPRESSION_H
+
+#include <gbdd/bdd-relation.h>
+#include <string>
+#include <map>
+
+namespace gbdd
+{
+	class BddExpression;
+
+	/// Graph of deferred operations on relations
+	/**
+	 * Operations on gbdd::BddExpression objects only add nodes to
+	 * the graph of their expressions. Nodes are shared, so an
+	 * expression built twice from the same operands is the same node.
+	 * When an expression is evaluated it is first rewritten:
+	 *
+	 * - restrictions are pushed towards the relations they restrict,
+	 * - projections of conjunctions are fused into one and-exists,
+	 * - nested projections and nested changes of domains are merged.
+	 *
+	 * Results of evaluated nodes are kept, so common subexpressions are
+	 * only computed once, also between evaluations of different expressions.
+	 *
+	 * \code
+	 * BddExpressionGraph graph;
+	 *
+	 * BddExpression a = graph.leaf(r1);
+	 * BddExpression b = graph.leaf(r2);
+	 *
+	 * BddRelation res = (a & b).project_columns(columns).restrict(0, s).evaluate();
+	 * \endcode
+	 */
+	class BddExpressionGraph
+	{
+	public:
+		typedef unsigned int Node;
+	private:
+		enum Kind
+		{
+			LEAF,
+			AND,
+			OR,
+			MINUS,
+			NOT,
+			RESTRICT,
+			PROJECT_COLUMNS,
+			AND_PROJECT,
+			RENAME
+		};
+
+		class NodeInfo
+		{
+		public:
+			Kind kind;
+			Node a;
+			Node b;
+			unsigned int domain_index;
+			unsigned int value;
+			vector<unsigned int> columns;
+			Domains domains;
+		};
+
+		static const Node no_node;
+
+		vector<NodeInfo> nodes;
+		vector<BddRelation> values;
+		vector<Domains> renamed_domains;
+		map<string, Node> unique;
+
+		vector<Node> optimized;
+		hash_map<Node, BddRelation> results;
+
+		unsigned int n_evaluated;
+
+		unsigned int add_value(const BddRelation& r);
+		unsigned int add_domains(const Domains& ds);
+		Node add(const NodeInfo& info);
+
+		Node make_product(Kind kind, Node a, Node b);
+		Node make_restrict(Node a, unsigned int domain_index, unsigned int value);
+		Node make_project_columns(Node a, const vector<unsigned int>& columns);
+		Node make_and_project(Node a, Node b, const vector<unsigned int>& columns);
+		Node make_rename(Node a, const Domains& ds);
+
+		Node optimize(Node n);
+		Node push_restrict(Node n, unsigned int domain_index, unsigned int value);
+
+		const BddRelation& eval(Node n);
+
+		friend class BddExpression;
+	public:
+		BddExpressionGraph();
+
+		BddExpression leaf(const BddRelation& r);
+
+		unsigned int n_nodes() const;
+		unsigned int n_evaluations() const;
+
+		void clear_results();
+	};
+
+	/// Deferred relation
+	/**
+	 * An expression in a gbdd::BddExpressionGraph. The operations
+	 * mirror those of gbdd::BddRelation, but are only carried out
+	 * by BddExpression::evaluate.
+	 */
+	class BddExpression
+	{
+		BddExpressionGraph* graph;
+		BddExpressionGraph::Node node;
+
+		BddExpression(BddExpressionGraph* graph, BddExpressionGraph::Node node);
+
+		friend class BddExpressionGraph;
+	public:
+		BddExpression operator&(const BddExpression& e2) const;
+		BddExpression operator|(const BddExpression& e2) const;
+		BddExpression operator-(const BddExpression& e2) const;
+		BddExpression operator!() const;
+
+		BddExpression restrict(unsigned int domain_index, const BddSet& s) const;
+		BddExpression project_columns(const vector<unsigned int>& domain_indices) const;
+		BddExpression adapt(const Domains& ds) const;
+
+		const Domains& get_domains() const;
+
+		BddRelation evaluate() const;
+	};
+}
+
+#endif /* BDD_EXPRESSION_H */
@@ -0,0 +1,316 @@
+/*
+ * bdd-partitioned-relation.cc: 
+ *
+ * Copyright (C) 2004 Marcus Nilsson (marcusn@it.uu.se)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ * 
+ * Authors:
+ *    Marcus Nilsson (marcusn@it.uu.se)
+ */
+
+#include <gbdd/bdd-partitioned-relation.h>
+#include <gbdd/sgi_ext.h>
+#include <assert.h>
+
+namespace gbdd
+{
+
+/// Constructor for relation without parts
+/**
+ * An empty conjunctive relation is the universal relation and an
+ * empty disjunctive relation is the empty relation.
+ *
+ * @param space Space of the parts
+ * @param partitioning Whether the relation is the conjunction or the disjunction of its parts
+ * @param domain1 First domain, must be finite
+ * @param domain2 Second domain, must be finite and disjoint from \a domain1
+ * @param cluster_limit Largest number of nodes in a BDD obtained by merging parts
+ */
+BddPartitionedRelation::BddPartitionedRelation(Space* space,
+					       Partitioning partitioning,
+					       const Domain& domain1,
+					       const Domain& domain2,
+					       unsigned int cluster_limit):
+	space(space),
+	partitioning(partitioning),
+	dom_range(domain1),
+	dom_image(domain2),
+	cluster_limit(cluster_limit),
+	scheduled(false)
+{
+	assert(dom_range.is_finite() && dom_image.is_finite());
+	assert(dom_range.is_disjoint(dom_image));
+}
+
+/// Add part
+/**
+ * @param part Binary relation with domains compatible with the domains of this relation
+ */
+void BddPartitionedRelation::add(const BddRelation& part)
+{
+	assert(part.arity() == 2);
+
+	parts.push_back(BddRelation(dom_range * dom_image, part).get_bdd());
+	scheduled = false;
+}
+
+/// Get partitioning
+/**
+ * @return Whether the relation is the conjunction or the disjunction of its parts
+ */
+BddPartitionedRelation::Partitioning BddPartitionedRelation::get_partitioning() const
+{
+	return partitioning;
+}
+
+/// Get number of parts
+/**
+ * @return Number of parts added
+ */
+unsigned int BddPartitionedRelation::n_parts() const
+{
+	return parts.size();
+}
+
+/// Get number of clusters
+/**
+ * @return Number of clusters used when computing images
+ */
+unsigned int BddPartitionedRelation::n_clusters() const
+{
+	schedule();
+
+	return image_schedule.clusters.size();
+}
+
+/// Build relation
+/**
+ * This builds the BDD of the whole relation, which images and
+ * preimages avoid.
+ *
+ * @return The relation as one BDD
+ */
+BddBinaryRelation BddPartitionedRelation::get_relation() const
+{
+	Bdd rel(space, partitioning == CONJUNCTIVE);
+
+	for (vector<Bdd>::const_iterator i = parts.begin();i != parts.end();++i)
+	{
+		if (partitioning == CONJUNCTIVE)
+		{
+			rel &= *i;
+		}
+		else
+		{
+			rel |= *i;
+		}
+	}
+
+	return BddBinaryRelation(dom_range, dom_image, rel);
+}
+
+/// Order parts for early quantification
+/**
+ * Parts are chosen greedily, each time taking the part with the largest
+ * fraction of its variables to quantify that no other remaining part
+ * depends on.
+ *
+ * @param vs Variables to quantify
+ * 
+ * @return The parts in the order to conjoin them
+ */
+vector<Bdd> BddPartitionedRelation::order_parts(const Domain& vs) const
+{
+	vector<Bdd> remaining = parts;
+	vector<Domain> supports;
+	hash_map<Domain::Var, unsigned int> n_dependent;
+
+	for (vector<Bdd>::const_iterator i = remaining.begin();i != remaining.end();++i)
+	{
+		Domain support = i->vars() & vs;
+
+		for (Domain::const_iterator v = support.begin();v != support.end();++v)
+		{
+			n_dependent[*v]++;
+		}
+
+		supports.push_back(support);
+	}
+
+	vector<Bdd> ordered;
+
+	while (!remaining.empty())
+	{
+		unsigned int best = 0;
+		double best_score = -1;
+
+		for (unsigned int j = 0;j < remaining.size();++j)
+		{
+			unsigned int n_local = 0;
+
+			for (Domain::const_iterator v = supports[j].begin();v != supports[j].end();++v)
+			{
+				if (n_dependent[*v] == 1) n_local++;
+			}
+
+			double score = supports[j].is_empty() ? 0 : ((double)n_local) / supports[j].size();
+
+			if (score > best_score)
+			{
+				best = j;
+				best_score = score;
+			}
+		}
+
+		for (Domain::const_iterator v = supports[best].begin();v != supports[best].end();++v)
+		{
+			n_dependent[*v]--;
+		}
+
+		ordered.push_back(remaining[best]);
+
+		remaining.erase(remaining.begin() + best);
+		supports.erase(supports.begin() + best);
+	}
+
+	return ordered;
+}
+
+/// Compute clusters and quantification schedule
+/**
+ * @param vs Variables to quantify
+ * @param s Schedule to assign
+ */
+void BddPartitionedRelation::make_schedule(const Domain& vs, Schedule& s) const
+{
+	vector<Bdd> ordered = (partitioning == CONJUNCTIVE) ? order_parts(vs) : parts;
+
+	s.clusters.clear();
+	s.quantify.clear();
+
+	for (vector<Bdd>::const_iterator i = ordered.begin();i != ordered.end();++i)
+	{
+		if (!s.clusters.empty())
+		{
+			Bdd merged = (partitioning == CONJUNCTIVE) ? (s.clusters.back() & *i) : (s.clusters.back() | *i);
+
+			if (merged.nodes().size() <= cluster_limit)
+			{
+				s.clusters.back() = merged;
+				continue;
+			}
+		}
+
+		s.clusters.push_back(*i);
+	}
+
+	if (partitioning == DISJUNCTIVE) return;
+
+	// Quantify a variable right after the last cluster depending on it
+
+	unsigned int n = s.clusters.size();
+	vector<Domain> later(n + 1);
+
+	for (unsigned int i = n;i > 0;--i)
+	{
+		later[i - 1] = later[i] | s.clusters[i - 1].vars();
+	}
+
+	Domain quantified;
+
+	for (unsigned int i = 0;i < n;++i)
+	{
+		Domain q = (vs - later[i + 1]) - quantified;
+
+		s.quantify.push_back(q);
+		quantified |= q;
+	}
+}
+
+/// Compute schedules if parts have been added
+void BddPartitionedRelation::schedule() const
+{
+	if (scheduled) return;
+
+	make_schedule(dom_range, image_schedule);
+	make_schedule(dom_image, preimage_schedule);
+
+	scheduled = true;
+}
+
+/// Apply relation
+/**
+ * @param p BDD over the domain \a vs
+ * @param vs Domain to quantify
+ * @param s Schedule for \a vs
+ * 
+ * @return The conjunction or disjunction of \a p with the parts, with \a vs projected away
+ */
+Bdd BddPartitionedRelation::apply(const Bdd& p, const Domain& vs, const Schedule& s) const
+{
+	if (partitioning == CONJUNCTIVE)
+	{
+		if (s.clusters.empty()) return p.project(vs);
+
+		Bdd res = p;
+
+		for (unsigned int i = 0;i < s.clusters.size();++i)
+		{
+			res = Bdd::and_project(res, s.clusters[i], s.quantify[i]);
+		}
+
+		return res;
+	}
+	else
+	{
+		Bdd res(space, false);
+
+		for (vector<Bdd>::const_iterator i = s.clusters.begin();i != s.clusters.end();++i)
+		{
+			res |= Bdd::and_project(*i, p, vs);
+		}
+
+		return res;
+	}
+}
+
+/// Image of set
+/**
+ * @param s Set with domain compatible with the first domain
+ * 
+ * @return The set of elements related to some element of \a s, over the second domain
+ */
+BddSet BddPartitionedRelation::image_under(const BddSet& s) const
+{
+	schedule();
+
+	return BddSet(dom_image, apply(BddSet(dom_range, s).get_bdd(), dom_range, image_schedule));
+}
+
+/// Preimage of set
+/**
+ * @param s Set with domain compatible with the second domain
+ * 
+ * @return The set of elements related to some element of \a s, over the first domain
+ */
+BddSet BddPartitionedRelation::range_under(const BddSet& s) const
+{
+	schedule();
+
+	return BddSet(dom_range, apply(BddSet(dom_image, s).get_bdd(), dom_image, preimage_schedule));
+}
+
+}
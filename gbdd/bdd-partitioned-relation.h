@@ -0,0 +1,107 @@
+/*
+ * bdd-partitioned-relation.h: 
+ *
+ * Copyright (C) 2004 Marcus Nilsson (marcusn@it.uu.se)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ * 
+ * Authors:
+ *    Marcus Nilsson (marcusn@it.uu.se)
+ */
+
+#ifndef BDD_PARTITIONED_RELATION_H
+#define BDD_PARTITIONED_RELATION_H
+
+#include <gbdd/bdd-relation.h>
+
+namespace gbdd
+{
+	/// A binary relation kept as a list of parts
+	/**
+	 * A partitioned relation is the conjunction or the disjunction of
+	 * a number of binary relations over the same two domains. Images
+	 * and preimages are computed one part at a time, so the BDD of the
+	 * whole relation is never built.
+	 *
+	 * Small parts are merged into clusters as long as the BDD of a
+	 * cluster has at most a given number of nodes. For conjunctive
+	 * relations the clusters are ordered so that variables can be
+	 * quantified early, and each variable is quantified in the step
+	 * after which no remaining cluster depends on it.
+	 *
+	 * \code
+	 * BddPartitionedRelation next(space, BddPartitionedRelation::CONJUNCTIVE, d0, d1);
+	 *
+	 * next.add(BddRelation(d0 * d1, bit_0_next));
+	 * next.add(BddRelation(d0 * d1, bit_1_next));
+	 *
+	 * BddSet successors = next.image_under(s);
+	 * \endcode
+	 */
+	class BddPartitionedRelation
+	{
+	public:
+		/// How the parts are combined
+		enum Partitioning
+		{
+			CONJUNCTIVE,
+			DISJUNCTIVE
+		};
+	private:
+		/// Clusters and variables to quantify after each of them
+		class Schedule
+		{
+		public:
+			vector<Bdd> clusters;
+			vector<Domain> quantify;
+		};
+
+		Space* space;
+		Partitioning partitioning;
+		Domain dom_range;
+		Domain dom_image;
+		unsigned int cluster_limit;
+
+		vector<Bdd> parts;
+
+		mutable bool scheduled;
+		mutable Schedule image_schedule;
+		mutable Schedule preimage_schedule;
+
+		void schedule() const;
+		vector<Bdd> order_parts(const Domain& vs) const;
+		void make_schedule(const Domain& vs, Schedule& s) const;
+		Bdd apply(const Bdd& p, const Domain& vs, const Schedule& s) const;
+	public:
+		BddPartitionedRelation(Space* space,
+				       Partitioning partitioning,
+				       const Domain& domain1,
+				       const Domain& domain2,
+				       unsigned int cluster_limit = 1000);
+
+		void add(const BddRelation& part);
+
+		Partitioning get_partitioning() const;
+		unsigned int n_parts() const;
+		unsigned int n_clusters() const;
+
+		BddBinaryRelation get_relation() const;
+
+		BddSet image_under(const BddSet& s) const;
+		BddSet range_under(const BddSet& s) const;
+	};
+}
+
+#endif /* BDD_PARTITIONED_RELATION_H */
@@ -0,0 +1,227 @@
+/*
+ * bdd-reachability.cc: 
+ *
+ * Copyright (C) 2004 Marcus Nilsson (marcusn@it.uu.se)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ * 
+ * Authors:
+ *    Marcus Nilsson (marcusn@it.uu.se)
+ */
+
+#include <gbdd/bdd-reachability.h>
+#include <assert.h>
+
+namespace gbdd
+{
+
+/// Constructor
+/**
+ * @param rel Relation to explore, its domains must be finite and disjoint
+ */
+BddReachability::BddReachability(const BddBinaryRelation& rel):
+	rel_bdd(rel.get_bdd()),
+	dom_range(rel.get_domain(0)),
+	dom_image(rel.get_domain(1))
+{
+	assert(dom_range.is_finite() && dom_image.is_finite());
+	assert(dom_range.is_disjoint(dom_image));
+	assert(dom_range.size() == dom_image.size());
+
+	image_to_range = Domain::map_vars(dom_image, dom_range);
+	range_to_image = Domain::map_vars(dom_range, dom_image);
+}
+
+/// Image over the range domain
+/**
+ * @param p BDD over the range domain
+ * 
+ * @return Image of \a p, over the range domain
+ */
+Bdd BddReachability::image(const Bdd& p) const
+{
+	return Bdd::and_project(rel_bdd, p, dom_range).rename(image_to_range);
+}
+
+/// Preimage over the range domain
+/**
+ * @param p BDD over the range domain
+ * 
+ * @return Preimage of \a p, over the range domain
+ */
+Bdd BddReachability::preimage(const Bdd& p) const
+{
+	return Bdd::and_project(rel_bdd, p.rename(range_to_image), dom_image);
+}
+
+/// Image of set
+/**
+ * @param s Set to take image of
+ * 
+ * @return The set of elements related to some element of \a s, over the domain of \a s
+ */
+BddSet BddReachability::image(const BddSet& s) const
+{
+	return BddSet(s.get_domain(), BddSet(dom_range, image(BddSet(dom_range, s).get_bdd())));
+}
+
+/// Preimage of set
+/**
+ * @param s Set to take preimage of
+ * 
+ * @return The set of elements related to some element of \a s, over the domain of \a s
+ */
+BddSet BddReachability::preimage(const BddSet& s) const
+{
+	return BddSet(s.get_domain(), BddSet(dom_range, preimage(BddSet(dom_range, s).get_bdd())));
+}
+
+/// Explore relation from set
+/**
+ * @param start Set to start from
+ * @param forward Whether to take images or preimages
+ * @param target If not NULL, stop when an element of this set is reached
+ * @param layers If not NULL, the sets of elements first reached in each step are added to this vector
+ * @param reached Set to assign the reached elements to
+ * 
+ * @return Whether \a target was hit
+ */
+bool BddReachability::explore(const BddSet& start, bool forward, const BddSet* target,
+			      vector<BddSet>* layers, BddSet& reached) const
+{
+	Domain dom_start = start.get_domain();
+
+	Bdd reached_bdd = BddSet(dom_range, start).get_bdd();
+	Bdd frontier = reached_bdd;
+	Bdd target_bdd = (target != NULL) ? BddSet(dom_range, *target).get_bdd() : Bdd(rel_bdd.get_space(), false);
+
+	bool hit = frontier.intersects(target_bdd);
+
+	if (layers != NULL) layers->push_back(BddSet(dom_start, BddSet(dom_range, frontier)));
+
+	while (!hit && !frontier.is_false())
+	{
+		frontier = (forward ? image(frontier) : preimage(frontier)) - reached_bdd;
+
+		if (frontier.is_false()) break;
+
+		reached_bdd |= frontier;
+		hit = frontier.intersects(target_bdd);
+
+		if (layers != NULL) layers->push_back(BddSet(dom_start, BddSet(dom_range, frontier)));
+	}
+
+	reached = BddSet(dom_start, BddSet(dom_range, reached_bdd));
+
+	return hit;
+}
+
+/// Forward reachability
+/**
+ * @param s Set to start from
+ * 
+ * @return The set of elements reachable from \a s in zero or more steps
+ */
+BddSet BddReachability::forward(const BddSet& s) const
+{
+	BddSet reached;
+
+	explore(s, true, NULL, NULL, reached);
+
+	return reached;
+}
+
+/// Backward reachability
+/**
+ * @param s Set to start from
+ * 
+ * @return The set of elements from which \a s is reachable in zero or more steps
+ */
+BddSet BddReachability::backward(const BddSet& s) const
+{
+	BddSet reached;
+
+	explore(s, false, NULL, NULL, reached);
+
+	return reached;
+}
+
+/// Forward reachability with layers
+/**
+ * @param s Set to start from
+ * @param layers Vector to add the elements at distance 0, 1, ... from \a s to
+ * 
+ * @return The set of elements reachable from \a s in zero or more steps
+ */
+BddSet BddReachability::forward(const BddSet& s, vector<BddSet>& layers) const
+{
+	BddSet reached;
+
+	explore(s, true, NULL, &layers, reached);
+
+	return reached;
+}
+
+/// Backward reachability with layers
+/**
+ * @param s Set to start from
+ * @param layers Vector to add the elements at distance 0, 1, ... to \a s to
+ * 
+ * @return The set of elements from which \a s is reachable in zero or more steps
+ */
+BddSet BddReachability::backward(const BddSet& s, vector<BddSet>& layers) const
+{
+	BddSet reached;
+
+	explore(s, false, NULL, &layers, reached);
+
+	return reached;
+}
+
+/// Forward reachability until target is hit
+/**
+ * Exploration stops at the first layer containing an element of \a target
+ *
+ * @param s Set to start from
+ * @param target Set to look for
+ * @param layers Vector to add the layers explored to, the last one intersects \a target if it was hit
+ * 
+ * @return Whether some element of \a target is reachable from \a s
+ */
+bool BddReachability::forward_hits(const BddSet& s, const BddSet& target, vector<BddSet>& layers) const
+{
+	BddSet reached;
+
+	return explore(s, true, &target, &layers, reached);
+}
+
+/// Backward reachability until target is hit
+/**
+ * Exploration stops at the first layer containing an element of \a target
+ *
+ * @param s Set to start from
+ * @param target Set to look for
+ * @param layers Vector to add the layers explored to, the last one intersects \a target if it was hit
+ * 
+ * @return Whether \a s is reachable from some element of \a target
+ */
+bool BddReachability::backward_hits(const BddSet& s, const BddSet& target, vector<BddSet>& layers) const
+{
+	BddSet reached;
+
+	return explore(s, false, &target, &layers, reached);
+}
+
+}
@@ -0,0 +1,85 @@
+/*
+ * bdd-reachability.h: 
+ *
+ * Copyright (C) 2004 Marcus Nilsson (marcusn@it.uu.se)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ * 
+ * Authors:
+ *    Marcus Nilsson (marcusn@it.uu.se)
+ */
+
+#ifndef BDD_REACHABILITY_H
+#define BDD_REACHABILITY_H
+
+#include <gbdd/bdd-relation.h>
+
+namespace gbdd
+{
+	/// Reachability analysis over a binary relation
+	/**
+	 * Computes the sets reachable forwards or backwards from a set in the
+	 * transitive closure of a binary relation. Only the frontier of states
+	 * that were new in the last step is explored, and each step computes the
+	 * image with a fused conjunction and projection followed by a single
+	 * renaming back to the range domain of the relation.
+	 *
+	 * Sets may be given over any domain with as many variables as the
+	 * domains of the relation, and results are returned over the domain
+	 * of the set given.
+	 *
+	 * \code
+	 * BddReachability reachability(rel);
+	 *
+	 * BddSet reached = reachability.forward(initial);
+	 *
+	 * vector<BddSet> layers;
+	 * if (reachability.forward_hits(initial, bad, layers))
+	 * {
+	 *	// layers.back() is the first layer containing a bad state
+	 * }
+	 * \endcode
+	 */
+	class BddReachability
+	{
+		Bdd rel_bdd;
+		Domain dom_range;
+		Domain dom_image;
+		Domain::VarMap image_to_range;
+		Domain::VarMap range_to_image;
+
+		Bdd image(const Bdd& p) const;
+		Bdd preimage(const Bdd& p) const;
+
+		bool explore(const BddSet& start, bool forward, const BddSet* target,
+			     vector<BddSet>* layers, BddSet& reached) const;
+	public:
+		BddReachability(const BddBinaryRelation& rel);
+
+		BddSet image(const BddSet& s) const;
+		BddSet preimage(const BddSet& s) const;
+
+		BddSet forward(const BddSet& s) const;
+		BddSet backward(const BddSet& s) const;
+
+		BddSet forward(const BddSet& s, vector<BddSet>& layers) const;
+		BddSet backward(const BddSet& s, vector<BddSet>& layers) const;
+
+		bool forward_hits(const BddSet& s, const BddSet& target, vector<BddSet>& layers) const;
+		bool backward_hits(const BddSet& s, const BddSet& target, vector<BddSet>& layers) const;
+	};
+}
+
+#endif /* BDD_REACHABILITY_H */
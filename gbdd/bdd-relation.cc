@@ -53,6 +53,61 @@ bool BddRelation::is_false() const
 	return get_bdd().is_false();
 }
 
+/// Test for common elements
+/**
+ * @param r2 Relation with the same arity
+ * 
+ * @return Whether this relation and \a r2 have some element in common
+ */
+bool BddRelation::intersects(const BddRelation& r2) const
+{
+	Domains res_domains = Domains::sup(get_domains(), r2.get_domains());
+
+	return BddRelation(res_domains, *this).get_bdd().intersects(BddRelation(res_domains, r2).get_bdd());
+}
+
+/// Test for subset
+/**
+ * @param r2 Relation with the same arity
+ * 
+ * @return Whether every element of this relation is an element of \a r2
+ */
+bool BddRelation::is_subset_of(const BddRelation& r2) const
+{
+	Domains res_domains = Domains::sup(get_domains(), r2.get_domains());
+
+	return BddRelation(res_domains, *this).get_bdd().leq(BddRelation(res_domains, r2).get_bdd());
+}
+
+/// Minimize with respect to care set
+/**
+ * Elements outside \a care are added or removed if that makes the
+ * representation smaller.
+ *
+ * @param care Relation with the same arity
+ * 
+ * @return Relation with the same elements as this relation in \a care
+ */
+BddRelation BddRelation::minimize(const BddRelation& care) const
+{
+	BddRelation r_care(get_domains(), care);
+
+	return BddRelation(get_domains(), get_bdd().restrict(r_care.get_bdd()));
+}
+
+/// Test membership of many tuples
+/**
+ * Evaluates the tuples in blocks with gbdd::BddBatchEvaluator.
+ *
+ * @param values Values of the tuples in column-major order, values[i][k] is the value of domain i in tuple k
+ * 
+ * @return For each tuple, whether it is an element of this relation
+ */
+vector<bool> BddRelation::contains_batch(const vector<vector<unsigned int> >& values) const
+{
+	return BddBatchEvaluator(get_domains(), get_bdd()).evaluate(values);
+}
+
 /// Test for true
 /**
  * @return Whether this relation is universal
@@ -161,6 +216,171 @@ vector<BddRelation> BddRelation::color(unsigned int domain_index,
 	return res;
 }
 
+/// Selects elements with a value in a component
+/**
+ * @param domain_index Index of component
+ * @param v Value
+ * 
+ * @return The elements of this relation with value \a v in component \a domain_index
+ */
+
+BddRelation BddRelation::select(unsigned int domain_index, unsigned int v) const
+{
+	return BddRelation(get_domains(), get_bdd() & Bdd::value(get_space(), get_domain(domain_index), v));
+}
+
+/// Composes relation with several binary relations
+/**
+ * Gives the same relation as composing with each relation of \a
+ * compose_rels in turn, but the relations are only renamed once, into a
+ * layout where the second domain of each relation is the first domain
+ * of the next one composed in the same component. The conjunctions are
+ * then done pairwise, smallest BDDs first, each with the fused
+ * and-exists of the variables no remaining relation depends on.
+ *
+ * @param domain_indices Index of component to compose each relation with
+ * @param compose_rels Binary relations to compose with, in order
+ * 
+ * @return The relation obtained by applying \a compose_rels [i] in
+ *         component \a domain_indices [i] of this relation, for each i
+ */
+
+BddRelation BddRelation::compose_all(const vector<unsigned int>& domain_indices,
+				     const vector<BddRelation>& compose_rels) const
+{
+	assert(domain_indices.size() == compose_rels.size());
+
+	bool some_infinite = get_domains().is_some_infinite();
+
+	for (unsigned int j = 0;j < compose_rels.size();++j)
+	{
+		some_infinite = some_infinite || compose_rels[j].get_domains().is_some_infinite();
+	}
+
+	if (some_infinite)
+	{
+		BddRelation res = *this;
+
+		for (unsigned int j = 0;j < compose_rels.size();++j)
+		{
+			res = res.compose(domain_indices[j], compose_rels[j]);
+		}
+
+		return res;
+	}
+
+	// Lay out the relations so that each one is only renamed once
+
+	Domains doms = get_domains();
+
+	StructureConstraint::VarPool pool;
+	pool.alloc(doms.union_all());
+
+	vector<Bdd> factors;
+	vector<Domain> factor_vars;
+
+	factors.push_back(get_bdd());
+	factor_vars.push_back(doms.union_all());
+
+	for (unsigned int j = 0;j < compose_rels.size();++j)
+	{
+		unsigned int i = domain_indices[j];
+		const BddRelation& r = compose_rels[j];
+
+		assert(i < arity());
+		assert(r.arity() == 2);
+		assert(doms[i].is_compatible(r.get_domain(0)));
+
+		Domain dom_from = doms[i];
+		Domain dom_to = r.get_domain(1);
+
+		if (r.get_domain(0) != dom_from || !pool.alloc(dom_to))
+		{
+			dom_to = pool.alloc(dom_from.size());
+		}
+
+		factors.push_back(BddRelation(dom_from * dom_to, r).get_bdd());
+		factor_vars.push_back(dom_from | dom_to);
+
+		doms[i] = dom_to;
+	}
+
+	Domain result_vars = doms.union_all();
+
+	while (factors.size() > 1)
+	{
+		// Conjoin the related pair with the smallest product of sizes
+
+		vector<unsigned int> sizes;
+
+		for (unsigned int a = 0;a < factors.size();++a)
+		{
+			sizes.push_back(factors[a].nodes().size());
+		}
+
+		unsigned int best_a = 0;
+		unsigned int best_b = 1;
+		unsigned long int best_cost = 0;
+		bool found = false;
+
+		for (unsigned int a = 0;a < factors.size();++a)
+		{
+			for (unsigned int b = a + 1;b < factors.size();++b)
+			{
+				if ((factor_vars[a] & factor_vars[b]).is_empty()) continue;
+
+				unsigned long int cost = ((unsigned long int)sizes[a]) * sizes[b];
+
+				if (!found || cost < best_cost)
+				{
+					best_a = a;
+					best_b = b;
+					best_cost = cost;
+					found = true;
+				}
+			}
+		}
+
+		Domain others = result_vars;
+
+		for (unsigned int k = 0;k < factors.size();++k)
+		{
+			if (k != best_a && k != best_b) others |= factor_vars[k];
+		}
+
+		Domain vs = factor_vars[best_a] | factor_vars[best_b];
+		Domain quantify = vs - others;
+
+		factors[best_a] = Bdd::and_project(factors[best_a], factors[best_b], quantify);
+		factor_vars[best_a] = vs - quantify;
+
+		factors.erase(factors.begin() + best_b);
+		factor_vars.erase(factor_vars.begin() + best_b);
+	}
+
+	Bdd res = factors[0];
+	Domain quantify = factor_vars[0] - result_vars;
+
+	if (!quantify.is_empty()) res = res.project(quantify);
+
+	return BddRelation(doms, res);
+}
+
+/// Composes relation with several binary relations in the same component
+/**
+ * @param domain_index Index of component to compose with
+ * @param compose_rels Binary relations to compose with, in order
+ * 
+ * @return The same relation as composing with each relation of \a
+ *         compose_rels in turn in component \a domain_index
+ */
+
+BddRelation BddRelation::compose_chain(unsigned int domain_index,
+				       const vector<BddRelation>& compose_rels) const
+{
+	return compose_all(vector<unsigned int>(compose_rels.size(), domain_index), compose_rels);
+}
+
 /// Inserts an element into the relation
 /**
  * The domains of the relation are extended if necessary
@@ -370,6 +590,19 @@ bool BddSet::member(unsigned int v) const
 	return get_bdd().value_member(get_domain(), v);
 }
 
+/// Test membership of many values
+/**
+ * Evaluates the values in blocks with gbdd::BddBatchEvaluator.
+ *
+ * @param values Values to test
+ * 
+ * @return For each value, whether it is a member of the set
+ */
+vector<bool> BddSet::member_batch(const vector<unsigned int>& values) const
+{
+	return contains_batch(vector<vector<unsigned int> >(1, values));
+}
+
 /// Test for emptiness
 /**
  * @return Whether set is empty
@@ -603,7 +836,7 @@ ostream& operator<<(ostream &out, const BddRelation &r)
 
 			BddRelation prod = StructureRelation::cross_product(r.get_domains(), element);
 
-			if (!(prod & r).is_false())
+			if (prod.get_bdd().intersects(r.get_bdd()))
 			{
 
 				out << "(" << *(is[0]);
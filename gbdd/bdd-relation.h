@@ -26,6 +26,7 @@
 #include <gbdd/structure-relation.h>
 #include <gbdd/structure-binary-relation.h>
 #include <gbdd/bdd.h>
+#include <gbdd/bdd-batch-evaluator.h>
 
 namespace gbdd
 {
@@ -150,6 +151,13 @@ return (composed_rel1 == rel2);
 		bool is_false() const;
 		bool is_true() const;
 
+		bool intersects(const BddRelation& r2) const;
+		bool is_subset_of(const BddRelation& r2) const;
+
+		BddRelation minimize(const BddRelation& care) const;
+
+		vector<bool> contains_batch(const vector<vector<unsigned int> >& values) const;
+
 		friend ostream& operator<<(ostream &out, const BddRelation &r);
 
 		static BddRelation enumeration(vector<BddSet>& sets);
@@ -159,6 +167,13 @@ return (composed_rel1 == rel2);
 					      Domain color_domain,
 					      vector<BddRelation> rels);
 
+		BddRelation select(unsigned int domain_index, unsigned int v) const;
+
+		BddRelation compose_all(const vector<unsigned int>& domain_indices,
+					const vector<BddRelation>& compose_rels) const;
+		BddRelation compose_chain(unsigned int domain_index,
+					  const vector<BddRelation>& compose_rels) const;
+
 		void insert(const vector<unsigned int>& vals);
 		void insert(unsigned int v1, unsigned int v2);
 	};
@@ -183,6 +198,7 @@ return (composed_rel1 == rel2);
 		static BddSet universal(const BddSet& set);
 
 		bool member(unsigned int v) const;
+		vector<bool> member_batch(const vector<unsigned int>& values) const;
 
 		bool is_empty() const;
 
@@ -0,0 +1,249 @@
+/*
+ * bdd-saturation.cc: 
+ *
+ * Copyright (C) 2004 Marcus Nilsson (marcusn@it.uu.se)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ * 
+ * Authors:
+ *    Marcus Nilsson (marcusn@it.uu.se)
+ */
+
+#include <gbdd/bdd-saturation.h>
+#include <algorithm>
+#include <assert.h>
+
+namespace gbdd
+{
+
+/// Constructor
+/**
+ * The states are kept in fresh domains allocated after all variables in
+ * \a ds, level by level from the top of the BDD, with the variables for
+ * the next values of a domain interleaved with its current variables.
+ *
+ * @param ds Domains of the states, must be finite and disjoint
+ */
+BddSaturation::BddSaturation(const Domains& ds):
+	domains(ds),
+	current_domains(ds.size()),
+	next_domains(ds.size()),
+	levels(ds.size())
+{
+	assert(!ds.is_some_infinite());
+
+	// Level 0 is the domain lowest in the BDDs
+
+	vector<unsigned int> by_level(ds.size());
+
+	for (unsigned int i = 0;i < ds.size();++i)
+	{
+		levels[i] = 0;
+
+		for (unsigned int j = 0;j < ds.size();++j)
+		{
+			if (ds[j].lowest() > ds[i].lowest()) levels[i]++;
+		}
+
+		by_level[levels[i]] = i;
+	}
+
+	StructureConstraint::VarPool pool;
+	pool.alloc(ds.union_all());
+
+	for (unsigned int level = ds.size();level > 0;--level)
+	{
+		unsigned int i = by_level[level - 1];
+		Domains pair = pool.alloc_interleaved(ds[i].size(), 2);
+
+		current_domains[i] = pair[0];
+		next_domains[i] = pair[1];
+
+		for (Domain::const_iterator v = pair[0].begin();v != pair[0].end();++v)
+		{
+			var_levels[*v] = level - 1;
+		}
+	}
+}
+
+/// Add event
+/**
+ * The domains in \a writes take values as given by \a rel, all
+ * other domains keep their values.
+ *
+ * @param reads Indices of domains the event reads
+ * @param writes Indices of domains the event writes
+ * @param rel Relation whose domains are the current values of \a reads followed by the next values of \a writes
+ */
+void BddSaturation::add_event(const vector<unsigned int>& reads,
+			      const vector<unsigned int>& writes,
+			      const BddRelation& rel)
+{
+	assert(rel.arity() == reads.size() + writes.size());
+
+	Domains rel_domains(reads.size() + writes.size());
+	Event e;
+
+	e.level = 0;
+
+	for (unsigned int i = 0;i < reads.size();++i)
+	{
+		assert(reads[i] < domains.size());
+
+		rel_domains[i] = current_domains[reads[i]];
+		e.level = std::max(e.level, levels[reads[i]]);
+	}
+
+	for (unsigned int i = 0;i < writes.size();++i)
+	{
+		assert(writes[i] < domains.size());
+
+		rel_domains[reads.size() + i] = next_domains[writes[i]];
+		e.written |= current_domains[writes[i]];
+		e.next_to_current = e.next_to_current | Domain::map_vars(next_domains[writes[i]], current_domains[writes[i]]);
+		e.level = std::max(e.level, levels[writes[i]]);
+	}
+
+	e.rel = BddRelation(rel_domains, rel).get_bdd();
+
+	events.push_back(e);
+}
+
+/// Get number of levels
+/**
+ * @return The number of levels, one per domain
+ */
+unsigned int BddSaturation::n_levels() const
+{
+	return domains.size();
+}
+
+/// Apply event
+/**
+ * @param e Event
+ * @param p BDD over the current variables
+ * 
+ * @return The states reached from \a p by one occurrence of \a e
+ */
+Bdd BddSaturation::apply(const Event& e, const Bdd& p) const
+{
+	return Bdd::and_project(p, e.rel, e.written).rename(e.next_to_current);
+}
+
+/// Saturate below level
+/**
+ * The nodes of \a p on variables of \a level are kept, and the nodes
+ * below them are saturated.
+ *
+ * @param p BDD over the current variables of \a level and the levels below
+ * @param level Level
+ * @param rebuilt Nodes of \a p on variables of \a level done so far
+ * @param saturated Saturated nodes per level
+ * 
+ * @return The states of \a p closed under the events below \a level
+ */
+Bdd BddSaturation::saturate_below(const Bdd& p, unsigned int level, BddCache& rebuilt,
+				  vector<BddCache>& saturated) const
+{
+	if (p.bdd_is_leaf()) return p;
+
+	hash_map<Domain::Var, unsigned int>::const_iterator var_level = var_levels.find(p.bdd_var());
+
+	assert(var_level != var_levels.end() && var_level->second <= level);
+
+	if (var_level->second < level) return saturate(p, level - 1, saturated);
+
+	BddCache::const_iterator i = rebuilt.find(p);
+
+	if (i != rebuilt.end()) return i->second;
+
+	Bdd r = Bdd::var_then_else(p.get_space(), p.bdd_var(),
+				   saturate_below(p.bdd_then(), level, rebuilt, saturated),
+				   saturate_below(p.bdd_else(), level, rebuilt, saturated));
+
+	rebuilt[p] = r;
+
+	return r;
+}
+
+/// Saturate node
+/**
+ * @param p BDD over the current variables of \a level and the levels below
+ * @param level Level
+ * @param saturated Saturated nodes per level
+ * 
+ * @return The states reachable from \a p by events of \a level and below
+ */
+Bdd BddSaturation::saturate(const Bdd& p, unsigned int level, vector<BddCache>& saturated) const
+{
+	if (p.bdd_is_leaf()) return p;
+
+	BddCache::const_iterator i = saturated[level].find(p);
+
+	if (i != saturated[level].end()) return i->second;
+
+	BddCache rebuilt;
+	Bdd r = saturate_below(p, level, rebuilt, saturated);
+
+	bool changed = true;
+
+	while (changed)
+	{
+		changed = false;
+
+		for (vector<Event>::const_iterator e = events.begin();e != events.end();++e)
+		{
+			if (e->level != level) continue;
+
+			Bdd new_states = apply(*e, r) - r;
+
+			while (!new_states.is_false())
+			{
+				BddCache new_rebuilt;
+
+				r |= saturate_below(new_states, level, new_rebuilt, saturated);
+				changed = true;
+
+				new_states = apply(*e, r) - r;
+			}
+		}
+	}
+
+	saturated[level][p] = r;
+
+	return r;
+}
+
+/// Compute reachable states
+/**
+ * @param initial Initial states, with domains compatible with the domains of the states
+ * 
+ * @return The states reachable from \a initial by zero or more events
+ */
+BddRelation BddSaturation::saturate(const BddRelation& initial) const
+{
+	Bdd reached = BddRelation(current_domains, BddRelation(domains, initial)).get_bdd();
+
+	if (n_levels() > 0)
+	{
+		vector<BddCache> saturated(n_levels());
+
+		reached = saturate(reached, n_levels() - 1, saturated);
+	}
+
+	return BddRelation(domains, BddRelation(current_domains, reached));
+}
+
+}
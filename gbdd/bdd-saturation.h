@@ -0,0 +1,103 @@
+/*
+ * bdd-saturation.h: 
+ *
+ * Copyright (C) 2004 Marcus Nilsson (marcusn@it.uu.se)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ * 
+ * Authors:
+ *    Marcus Nilsson (marcusn@it.uu.se)
+ */
+
+#ifndef BDD_SATURATION_H
+#define BDD_SATURATION_H
+
+#include <gbdd/bdd-relation.h>
+
+namespace gbdd
+{
+	/// Reachability by saturation over events
+	/**
+	 * The states are the elements of a relation over a tuple of
+	 * domains, and the transitions are given as events that each
+	 * read and write a few of the domains. An event leaves the
+	 * domains it does not write unchanged.
+	 *
+	 * The domains are ordered by their lowest variable, and an event
+	 * belongs to the level of its domain lowest in the BDD, i.e. with
+	 * the largest lowest variable. The reached set is saturated node
+	 * by node: for a node at a level, the nodes below the variables of
+	 * the level are saturated first, and then the events of the level
+	 * are fired until a fixpoint is reached, saturating the new states
+	 * below the level in the same way. Saturated nodes are cached per
+	 * level.
+	 *
+	 * The states are kept in internal domains, one block per level
+	 * with the next-state variables interleaved with the current-state
+	 * variables, so events relating the two stay small.
+	 *
+	 * \code
+	 * BddSaturation saturation(z.get_domains());
+	 *
+	 * vector<unsigned int> reads, writes;
+	 * reads.push_back(0);
+	 * writes.push_back(1);
+	 *
+	 * // Copy the value of the first domain to the second
+	 * saturation.add_event(reads, writes, copy);
+	 *
+	 * BddRelation reached = saturation.saturate(initial);
+	 * \endcode
+	 */
+	class BddSaturation
+	{
+		/// Event with its relation over current and next variables
+		class Event
+		{
+		public:
+			Bdd rel;
+			Domain written;
+			Domain::VarMap next_to_current;
+			unsigned int level;
+		};
+
+		typedef hash_map<Bdd, Bdd> BddCache;
+
+		Domains domains;
+		Domains current_domains;
+		Domains next_domains;
+		vector<unsigned int> levels;
+		hash_map<Domain::Var, unsigned int> var_levels;
+
+		vector<Event> events;
+
+		Bdd apply(const Event& e, const Bdd& p) const;
+		Bdd saturate(const Bdd& p, unsigned int level, vector<BddCache>& saturated) const;
+		Bdd saturate_below(const Bdd& p, unsigned int level, BddCache& rebuilt,
+				   vector<BddCache>& saturated) const;
+	public:
+		BddSaturation(const Domains& ds);
+
+		void add_event(const vector<unsigned int>& reads,
+			       const vector<unsigned int>& writes,
+			       const BddRelation& rel);
+
+		unsigned int n_levels() const;
+
+		BddRelation saturate(const BddRelation& initial) const;
+	};
+}
+
+#endif /* BDD_SATURATION_H */
@@ -0,0 +1,372 @@
+/*
+ * bdd-serializer.cc: 
+ *
+ * Copyright (C) 2004 Marcus Nilsson (marcusn@it.uu.se)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ * 
+ * Authors:
+ *    Marcus Nilsson (marcusn@it.uu.se)
+ */
+
+
+#include <gbdd/bdd-serializer.h>
+#include <stdio.h>
+#include <string.h>
+
+namespace gbdd
+{
+
+const char BddSerializer::magic[8] = { 'G', 'B', 'D', 'D', 'B', 'I', 'N', '1' };
+
+/// Write variable length unsigned integer
+/**
+ * @param os Stream to write on
+ * @param v Value to write
+ */
+static void write_uint(ostream& os, unsigned long int v)
+{
+	while (v >= 0x80)
+	{
+		os.put((char)((v & 0x7f) | 0x80));
+		v >>= 7;
+	}
+
+	os.put((char)v);
+}
+
+/// Read variable length unsigned integer
+/**
+ * @param is Stream to read from
+ * 
+ * @return The value read
+ */
+static unsigned long int read_uint(istream& is)
+{
+	unsigned long int v = 0;
+	unsigned int shift = 0;
+	int c;
+
+	do
+	{
+		c = is.get();
+
+		if (c == EOF) throw Space::Error("unexpected end of BDD file");
+
+		unsigned long int bits = c & 0x7f;
+
+		if (shift >= 8 * sizeof(v) || ((bits << shift) >> shift) != bits)
+			throw Space::Error("integer too large in BDD file");
+
+		v |= bits << shift;
+		shift += 7;
+	} while (c & 0x80);
+
+	return v;
+}
+
+/// Write domain
+/**
+ * A finite domain is written as 0, the number of variables and the variables
+ * as differences to the previous variable. An infinite domain is written as 1,
+ * its lowest variable and its step.
+ *
+ * @param os Stream to write on
+ * @param d Domain to write
+ */
+static void write_domain(ostream& os, const Domain& d)
+{
+	if (d.is_infinite())
+	{
+		Domain::const_iterator i = d.begin();
+		Domain::Var from = *i;
+
+		++i;
+
+		write_uint(os, 1);
+		write_uint(os, from);
+		write_uint(os, *i - from);
+	}
+	else
+	{
+		write_uint(os, 0);
+		write_uint(os, d.size());
+
+		Domain::Var previous = 0;
+		for (Domain::const_iterator i = d.begin();i != d.end();++i)
+		{
+			write_uint(os, *i - previous);
+			previous = *i;
+		}
+	}
+}
+
+/// Read domain
+/**
+ * @param is Stream to read from
+ * 
+ * @return The domain read
+ */
+static Domain read_domain(istream& is)
+{
+	if (read_uint(is) != 0)
+	{
+		Domain::Var from = read_uint(is);
+
+		return Domain::infinite(from, read_uint(is));
+	}
+
+	unsigned long int n_vars = read_uint(is);
+
+	set<Domain::Var> vars;
+	Domain::Var v = 0;
+	while (n_vars > 0)
+	{
+		v += read_uint(is);
+		vars.insert(v);
+		--n_vars;
+	}
+
+	return Domain(vars);
+}
+
+/// Number nodes children first
+/**
+ * @param p BDD to number the nodes of
+ * @param ids Numbers of nodes numbered so far
+ * @param nodes Nodes in order of their numbers, less the leaves
+ * 
+ * @return Number of \a p
+ */
+static unsigned long int number_nodes(const Bdd& p, hash_map<Bdd, unsigned long int>& ids, vector<Bdd>& nodes)
+{
+	if (p.bdd_is_leaf()) return p.bdd_leaf_value() ? 1 : 0;
+
+	hash_map<Bdd, unsigned long int>::const_iterator i = ids.find(p);
+
+	if (i != ids.end()) return i->second;
+
+	number_nodes(p.bdd_then(), ids, nodes);
+	number_nodes(p.bdd_else(), ids, nodes);
+
+	unsigned long int id = nodes.size() + 2;
+
+	ids[p] = id;
+	nodes.push_back(p);
+
+	return id;
+}
+
+/// Write BDDs and their domains
+/**
+ * @param os Stream to write on
+ * @param bdds BDDs to write
+ * @param domains Domains of each BDD, or NULL
+ */
+static void write_forest(ostream& os, const vector<Bdd>& bdds, const vector<Domains>* domains)
+{
+	os.write(BddSerializer::magic, sizeof(BddSerializer::magic));
+
+	write_uint(os, bdds.size());
+	write_uint(os, domains != NULL);
+
+	if (domains != NULL)
+	{
+		for (vector<Domains>::const_iterator i = domains->begin();i != domains->end();++i)
+		{
+			write_uint(os, i->size());
+
+			for (Domains::const_iterator j = i->begin();j != i->end();++j)
+			{
+				write_domain(os, *j);
+			}
+		}
+	}
+
+	hash_map<Bdd, unsigned long int> ids;
+	vector<Bdd> nodes;
+	vector<unsigned long int> roots;
+
+	for (vector<Bdd>::const_iterator i = bdds.begin();i != bdds.end();++i)
+	{
+		roots.push_back(number_nodes(*i, ids, nodes));
+	}
+
+	write_uint(os, nodes.size());
+
+	for (unsigned long int i = 0;i < nodes.size();++i)
+	{
+		const Bdd& p = nodes[i];
+		unsigned long int id = i + 2;
+
+		write_uint(os, p.bdd_var());
+		write_uint(os, id - number_nodes(p.bdd_then(), ids, nodes));
+		write_uint(os, id - number_nodes(p.bdd_else(), ids, nodes));
+	}
+
+	for (vector<unsigned long int>::const_iterator i = roots.begin();i != roots.end();++i)
+	{
+		write_uint(os, *i);
+	}
+}
+
+/// Read BDDs and their domains
+/**
+ * @param is Stream to read from
+ * @param space Space to create BDDs in
+ * @param domains Domains of each BDD are stored here, if the file has domains
+ * 
+ * @return The BDDs read
+ */
+static vector<Bdd> read_forest(istream& is, Space* space, vector<Domains>& domains)
+{
+	char header[sizeof(BddSerializer::magic)];
+
+	is.read(header, sizeof(header));
+
+	if (!is || memcmp(header, BddSerializer::magic, sizeof(header)) != 0)
+		throw Space::Error("not a BDD file");
+
+	unsigned long int n_bdds = read_uint(is);
+
+	if (read_uint(is) != 0)
+	{
+		for (unsigned long int i = 0;i < n_bdds;++i)
+		{
+			unsigned long int n_domains = read_uint(is);
+
+			// Counts are not trusted, so nothing is allocated before it is read
+
+			Domains ds;
+			for (unsigned long int j = 0;j < n_domains;++j)
+			{
+				ds = ds * read_domain(is);
+			}
+
+			domains.push_back(ds);
+		}
+	}
+
+	unsigned long int n_nodes = read_uint(is);
+
+	vector<Bdd> nodes;
+	nodes.push_back(Bdd(space, false));
+	nodes.push_back(Bdd(space, true));
+
+	for (unsigned long int i = 0;i < n_nodes;++i)
+	{
+		unsigned long int id = i + 2;
+		Bdd::Var v = read_uint(is);
+		unsigned long int then_back = read_uint(is);
+		unsigned long int else_back = read_uint(is);
+
+		if (then_back == 0 || then_back > id || else_back == 0 || else_back > id)
+			throw Space::Error("invalid node in BDD file");
+
+		const Bdd& p_then = nodes[id - then_back];
+		const Bdd& p_else = nodes[id - else_back];
+
+		if ((!p_then.bdd_is_leaf() && p_then.bdd_var() <= v) ||
+		    (!p_else.bdd_is_leaf() && p_else.bdd_var() <= v))
+			throw Space::Error("invalid variable order in BDD file");
+
+		nodes.push_back(Bdd::var_then_else(space, v, p_then, p_else));
+	}
+
+	vector<Bdd> res;
+	for (unsigned long int i = 0;i < n_bdds;++i)
+	{
+		unsigned long int id = read_uint(is);
+
+		if (id >= nodes.size()) throw Space::Error("invalid root in BDD file");
+
+		res.push_back(nodes[id]);
+	}
+
+	return res;
+}
+
+/// Write BDDs
+/**
+ * @param os Stream to write on, should be opened in binary mode
+ * @param bdds BDDs to write
+ */
+void BddSerializer::write(ostream& os, const vector<Bdd>& bdds)
+{
+	write_forest(os, bdds, NULL);
+}
+
+/// Write relations
+/**
+ * @param os Stream to write on, should be opened in binary mode
+ * @param rels Relations to write
+ */
+void BddSerializer::write(ostream& os, const vector<BddRelation>& rels)
+{
+	vector<Bdd> bdds;
+	vector<Domains> domains;
+
+	for (vector<BddRelation>::const_iterator i = rels.begin();i != rels.end();++i)
+	{
+		bdds.push_back(i->get_bdd());
+		domains.push_back(i->get_domains());
+	}
+
+	write_forest(os, bdds, &domains);
+}
+
+/// Read BDDs
+/**
+ * Throws gbdd::Space::Error if the stream does not contain a valid file.
+ *
+ * @param is Stream to read from
+ * @param space Space to create BDDs in
+ * 
+ * @return The BDDs in the file, in the order they were written
+ */
+vector<Bdd> BddSerializer::read(istream& is, Space* space)
+{
+	vector<Domains> domains;
+
+	return read_forest(is, space, domains);
+}
+
+/// Read relations
+/**
+ * Throws gbdd::Space::Error if the stream does not contain a valid file
+ * of relations.
+ *
+ * @param is Stream to read from
+ * @param space Space to create BDDs in
+ * 
+ * @return The relations in the file, in the order they were written
+ */
+vector<BddRelation> BddSerializer::read_relations(istream& is, Space* space)
+{
+	vector<Domains> domains;
+	vector<Bdd> bdds = read_forest(is, space, domains);
+
+	if (domains.size() != bdds.size()) throw Space::Error("BDD file has no domains");
+
+	vector<BddRelation> res;
+	for (unsigned long int i = 0;i < bdds.size();++i)
+	{
+		res.push_back(BddRelation(domains[i], bdds[i]));
+	}
+
+	return res;
+}
+
+}
@@ -0,0 +1,65 @@
+/*
+ * bdd-serializer.h: 
+ *
+ * Copyright (C) 2004 Marcus Nilsson (marcusn@it.uu.se)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ * 
+ * Authors:
+ *    Marcus Nilsson (marcusn@it.uu.se)
+ */
+
+
+#ifndef BDD_SERIALIZER_H
+#define BDD_SERIALIZER_H
+
+#include <gbdd/bdd-relation.h>
+#include <iostream>
+#include <vector>
+
+namespace gbdd
+{
+	/// Binary files of BDDs with shared nodes
+	/**
+	 * A file holds a set of BDDs as one array of nodes, where every
+	 * node shared between the BDDs, or within one BDD, is written
+	 * once. Nodes are written children first, so a file is read
+	 * in one pass. Relations are written with their domains.
+	 *
+	 * A file can be read into any space, also of another kind than
+	 * the space it was written from.
+	 *
+	 * The file starts with gbdd::BddSerializer::magic followed by
+	 * numbers encoded as variable length unsigned integers: the
+	 * number of BDDs, whether domains follow (and then the domains
+	 * of each relation), the number of nodes, each node as its
+	 * variable and the distance back to its then and else node, and
+	 * finally the root node of each BDD. The node numbers 0 and 1
+	 * are the false and true leaves.
+	 */
+	class BddSerializer
+	{
+	public:
+		static const char magic[8];
+
+		static void write(ostream& os, const vector<Bdd>& bdds);
+		static void write(ostream& os, const vector<BddRelation>& rels);
+
+		static vector<Bdd> read(istream& is, Space* space);
+		static vector<BddRelation> read_relations(istream& is, Space* space);
+	};
+}
+
+#endif /* BDD_SERIALIZER_H */
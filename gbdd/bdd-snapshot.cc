@@ -0,0 +1,350 @@
+/*
+ * bdd-snapshot.cc: 
+ *
+ * Copyright (C) 2004 Marcus Nilsson (marcusn@it.uu.se)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ * 
+ * Authors:
+ *    Marcus Nilsson (marcusn@it.uu.se)
+ */
+
+
+#include <gbdd/bdd-snapshot.h>
+#include <fstream>
+#include <string.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace gbdd
+{
+
+const char BddSnapshot::magic[8] = { 'G', 'B', 'D', 'D', 'S', 'N', 'P', '1' };
+
+static const uint32_t byte_order_mark = 0x01020304;
+static const uint32_t leaf_var = 0xffffffff;
+
+/// Header of snapshot file
+class BddSnapshotHeader
+{
+public:
+	char magic[8];
+	uint32_t byte_order_mark;
+	uint32_t n_nodes;
+	uint32_t n_roots;
+	uint32_t reserved;
+};
+
+/// Number nodes children first
+/**
+ * @param p BDD to number the nodes of
+ * @param ids Numbers of nodes numbered so far
+ * @param nodes Nodes in order of their numbers, less the leaves
+ * 
+ * @return Number of \a p
+ */
+static uint32_t number_nodes(const Bdd& p, hash_map<Bdd, uint32_t>& ids, vector<BddSnapshotNode>& nodes)
+{
+	if (p.bdd_is_leaf()) return p.bdd_leaf_value() ? 1 : 0;
+
+	hash_map<Bdd, uint32_t>::const_iterator i = ids.find(p);
+
+	if (i != ids.end()) return i->second;
+
+	BddSnapshotNode node;
+
+	node.var = p.bdd_var();
+	node.then_node = number_nodes(p.bdd_then(), ids, nodes);
+	node.else_node = number_nodes(p.bdd_else(), ids, nodes);
+
+	assert(node.var != leaf_var);
+
+	uint32_t id = nodes.size();
+
+	ids[p] = id;
+	nodes.push_back(node);
+
+	return id;
+}
+
+/// Write snapshot file
+/**
+ * Throws gbdd::Space::Error if the file can not be written.
+ *
+ * @param filename Name of file
+ * @param bdds BDDs to write
+ */
+void BddSnapshot::write(const string& filename, const vector<Bdd>& bdds)
+{
+	hash_map<Bdd, uint32_t> ids;
+	vector<BddSnapshotNode> nodes(2);
+	vector<uint32_t> roots;
+
+	nodes[0].var = nodes[1].var = leaf_var;
+	nodes[0].then_node = nodes[0].else_node = 0;
+	nodes[1].then_node = nodes[1].else_node = 1;
+
+	for (vector<Bdd>::const_iterator i = bdds.begin();i != bdds.end();++i)
+	{
+		roots.push_back(number_nodes(*i, ids, nodes));
+	}
+
+	BddSnapshotHeader header;
+
+	memcpy(header.magic, magic, sizeof(magic));
+	header.byte_order_mark = byte_order_mark;
+	header.n_nodes = nodes.size();
+	header.n_roots = roots.size();
+	header.reserved = 0;
+
+	ofstream os(filename.c_str(), ios::out | ios::binary | ios::trunc);
+
+	os.write((const char*)&header, sizeof(header));
+	if (!roots.empty()) os.write((const char*)&roots[0], roots.size() * sizeof(uint32_t));
+	os.write((const char*)&nodes[0], nodes.size() * sizeof(BddSnapshotNode));
+	os.close();
+
+	if (!os) throw Space::Error("could not write snapshot " + filename);
+}
+
+/// Constructor
+/**
+ * Maps a snapshot file read-only. The nodes are checked in place, without
+ * copying them. Throws gbdd::Space::Error if the file can not be mapped,
+ * is not a snapshot or is corrupt.
+ *
+ * @param filename Name of file written by write
+ */
+BddSnapshot::BddSnapshot(const string& filename):
+	data(MAP_FAILED),
+	length(0)
+{
+	int fd = open(filename.c_str(), O_RDONLY);
+
+	if (fd == -1) throw Space::Error("could not open snapshot " + filename);
+
+	struct stat st;
+
+	if (fstat(fd, &st) == 0 && (size_t)st.st_size >= sizeof(BddSnapshotHeader))
+	{
+		length = st.st_size;
+		data = mmap(NULL, length, PROT_READ, MAP_SHARED, fd, 0);
+	}
+
+	close(fd);
+
+	if (data == MAP_FAILED) throw Space::Error("could not map snapshot " + filename);
+
+	const BddSnapshotHeader* header = (const BddSnapshotHeader*)data;
+
+	if (memcmp(header->magic, magic, sizeof(magic)) != 0 ||
+	    header->byte_order_mark != byte_order_mark ||
+	    header->n_nodes < 2 ||
+	    length != sizeof(BddSnapshotHeader) +
+	    (size_t)header->n_roots * sizeof(uint32_t) +
+	    (size_t)header->n_nodes * sizeof(BddSnapshotNode))
+	{
+		munmap(data, length);
+		throw Space::Error("not a snapshot " + filename);
+	}
+
+	n_nodes = header->n_nodes;
+	n_roots = header->n_roots;
+	roots = (const uint32_t*)(header + 1);
+	nodes = (const BddSnapshotNode*)(roots + n_roots);
+
+	// One pass over the mapped nodes, so that walks of a corrupt file
+	// can not loop or leave the array
+
+	bool valid = true;
+
+	for (uint32_t i = 2;i < n_nodes && valid;++i)
+	{
+		uint32_t then_node = nodes[i].then_node;
+		uint32_t else_node = nodes[i].else_node;
+
+		valid =
+			then_node < i && else_node < i &&
+			(then_node < 2 || nodes[then_node].var > nodes[i].var) &&
+			(else_node < 2 || nodes[else_node].var > nodes[i].var);
+	}
+
+	for (uint32_t i = 0;i < n_roots && valid;++i)
+	{
+		valid = roots[i] < n_nodes;
+	}
+
+	if (!valid)
+	{
+		munmap(data, length);
+		throw Space::Error("corrupt snapshot " + filename);
+	}
+}
+
+/// Destructor
+/**
+ * Unmaps the file, all handles to its BDDs become invalid.
+ */
+BddSnapshot::~BddSnapshot()
+{
+	munmap(data, length);
+}
+
+/// Membership of value
+/**
+ * @param vs Variables to encode value in
+ * @param v Value to encode
+ * 
+ * @return True if \a v encoded in \a vs is a member, see gbdd::Bdd::value_member
+ */
+bool MappedBdd::value_member(const Domain& vs, unsigned int v) const
+{
+	uint32_t node = root;
+	Domain::const_iterator i = vs.begin();
+
+	while (node >= 2 && i != vs.end())
+	{
+		assert(nodes[node].var >= *i);
+
+		if (nodes[node].var == *i)
+		{
+			node = (v & 0x01) ? nodes[node].then_node : nodes[node].else_node;
+		}
+
+		++i;
+		v /= 2;
+	}
+
+	assert(node < 2);
+
+	return node == 1;
+}
+
+/// Predicate for variables in set
+class InVarSet
+{
+	const hash_set<Domain::Var>& vars;
+public:
+	InVarSet(const hash_set<Domain::Var>& vars) : vars(vars) {}
+
+	bool operator()(Domain::Var v) const { return vars.find(v) != vars.end(); }
+};
+
+/// Membership of tuple
+/**
+ * @param ds Domains to encode values in
+ * @param values Value for each domain
+ * 
+ * @return True if each value encoded in its domain is an assignment, false if some value is too large for its domain
+ */
+bool MappedBdd::member(const Domains& ds, const vector<unsigned int>& values) const
+{
+	assert(ds.size() == values.size());
+
+	hash_set<Var> true_vars;
+
+	for (unsigned int i = 0;i < values.size();++i)
+	{
+		unsigned int v = values[i];
+		Domain::const_iterator j = ds[i].begin();
+
+		for (;v > 0;++j, v /= 2)
+		{
+			if (j == ds[i].end()) return false;
+
+			if (v & 0x01) true_vars.insert(*j);
+		}
+	}
+
+	return evaluate(InVarSet(true_vars));
+}
+
+/// Count assignments of paths from node
+/**
+ * @param nodes Node array
+ * @param node Node
+ * @param positions Position of each variable in the domain counted over
+ * @param n_vars Number of variables in the domain
+ * @param cache Number of assignments to the variables below each node
+ * 
+ * @return Number of assignments to variables at positions from that of the variable of \a node that make \a node true
+ */
+static unsigned int n_assignments(const BddSnapshotNode* nodes,
+				  uint32_t node,
+				  const hash_map<Domain::Var, unsigned int>& positions,
+				  unsigned int n_vars,
+				  hash_map<uint32_t, unsigned int>& cache)
+{
+	hash_map<uint32_t, unsigned int>::const_iterator i = cache.find(node);
+
+	if (i != cache.end()) return i->second;
+
+	hash_map<Domain::Var, unsigned int>::const_iterator pos = positions.find(nodes[node].var);
+
+	assert(pos != positions.end());
+
+	unsigned int res = 0;
+	uint32_t children[2] = { nodes[node].then_node, nodes[node].else_node };
+
+	for (unsigned int j = 0;j < 2;++j)
+	{
+		uint32_t child = children[j];
+
+		if (child == 1)
+		{
+			res += 1 << (n_vars - pos->second - 1);
+		}
+		else if (child >= 2)
+		{
+			unsigned int child_pos = positions.find(nodes[child].var)->second;
+
+			res += (1 << (child_pos - pos->second - 1)) * n_assignments(nodes, child, positions, n_vars, cache);
+		}
+	}
+
+	cache[node] = res;
+
+	return res;
+}
+
+/// Get number of possible assignments
+/**
+ * All variables in the BDD must be in \a vs.
+ * 
+ * @param vs Variable to assign values to
+ * 
+ * @return The number of assignments to \a vs that make the BDD true
+ */
+unsigned int MappedBdd::n_assignments(const Domain& vs) const
+{
+	hash_map<Var, unsigned int> positions;
+	unsigned int n_vars = 0;
+
+	for (Domain::const_iterator i = vs.begin();i != vs.end();++i)
+	{
+		positions[*i] = n_vars++;
+	}
+
+	if (root < 2) return (root == 1) ? (1 << n_vars) : 0;
+
+	hash_map<uint32_t, unsigned int> cache;
+
+	return (1 << positions[nodes[root].var]) * gbdd::n_assignments(nodes, root, positions, n_vars, cache);
+}
+
+}
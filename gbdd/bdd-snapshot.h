@@ -0,0 +1,231 @@
+/*
+ * bdd-snapshot.h: 
+ *
+ * Copyright (C) 2004 Marcus Nilsson (marcusn@it.uu.se)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ * 
+ * Authors:
+ *    Marcus Nilsson (marcusn@it.uu.se)
+ */
+
+
+#ifndef BDD_SNAPSHOT_H
+#define BDD_SNAPSHOT_H
+
+#include <gbdd/bdd.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace gbdd
+{
+	/// Node of a BDD in a snapshot
+	/**
+	 * Nodes refer to each other by index, so a node array can be used at
+	 * any address. The indices 0 and 1 are the false and true leaves.
+	 */
+	class BddSnapshotNode
+	{
+	public:
+		uint32_t var;
+		uint32_t then_node;
+		uint32_t else_node;
+	};
+
+	/// Read-only BDD in a node array
+	/**
+	 * Walks the nodes directly, without any space. The node array must
+	 * outlive the handle.
+	 */
+	class MappedBdd
+	{
+		const BddSnapshotNode* nodes;
+		uint32_t root;
+
+		template <class Function>
+		void for_each_cube(uint32_t node, vector<pair<Domain::Var, bool> >& cube, Function& fn) const;
+	public:
+		typedef Domain::Var Var;
+
+		/// Cube, as the variables on a path to the true leaf with their values
+		typedef vector<pair<Var, bool> > Cube;
+
+/// Constructor
+/**
+ * @param nodes Node array
+ * @param root Index of root node in \a nodes
+ */
+		MappedBdd(const BddSnapshotNode* nodes, uint32_t root) : nodes(nodes), root(root) {}
+
+/// Test for leaf
+/**
+ * @return Whether this BDD is a leaf
+ */
+		bool is_leaf() const { return root < 2; }
+
+/// Get value of leaf
+/**
+ * @return Whether this leaf is the true leaf
+ */
+		bool leaf_value() const { return root == 1; }
+
+/// Get variable of root node
+/**
+ * @return The variable tested in the root node, which must not be a leaf
+ */
+		Var var() const { return nodes[root].var; }
+
+/// Get then branch
+/**
+ * @return The BDD when the root variable is true
+ */
+		MappedBdd then_bdd() const { return MappedBdd(nodes, nodes[root].then_node); }
+
+/// Get else branch
+/**
+ * @return The BDD when the root variable is false
+ */
+		MappedBdd else_bdd() const { return MappedBdd(nodes, nodes[root].else_node); }
+
+		template <class VarPredicate>
+		bool evaluate(VarPredicate fn_var) const;
+
+		bool value_member(const Domain& vs, unsigned int v) const;
+		bool member(const Domains& ds, const vector<unsigned int>& values) const;
+
+		unsigned int n_assignments(const Domain& vs) const;
+
+		template <class Function>
+		void for_each_cube(Function fn) const;
+	};
+
+	/// Read-only BDDs in a memory mapped file
+	/**
+	 * The file is an array of fixed size nodes that refer to each other
+	 * by index, so it is mapped as it is, without being copied.
+	 * Processes mapping the same file share its pages in the page cache.
+	 *
+	 * The file starts with gbdd::BddSnapshot::magic, a byte order mark,
+	 * the number of nodes and the number of BDDs as 32-bit integers,
+	 * followed by the root of each BDD and the nodes. Integers are
+	 * stored in the byte order of the writing machine, and a file with
+	 * another byte order is rejected. Nodes are written children first.
+	 *
+	 * Mapping checks in one pass that every node refers only to earlier
+	 * nodes with higher variables, and that every root is a node. The
+	 * pass takes time linear in the number of nodes and reads every page
+	 * of the file once, but copies nothing.
+	 */
+	class BddSnapshot
+	{
+		void* data;
+		size_t length;
+
+		const BddSnapshotNode* nodes;
+		const uint32_t* roots;
+		uint32_t n_nodes;
+		uint32_t n_roots;
+
+		BddSnapshot(const BddSnapshot&);
+		BddSnapshot& operator=(const BddSnapshot&);
+	public:
+		static const char magic[8];
+
+		static void write(const string& filename, const vector<Bdd>& bdds);
+
+		BddSnapshot(const string& filename);
+		~BddSnapshot();
+
+/// Get number of BDDs
+/**
+ * @return Number of BDDs in snapshot
+ */
+		unsigned int size() const { return n_roots; }
+
+/// Get number of nodes
+/**
+ * @return Number of nodes in snapshot, including the leaves
+ */
+		unsigned int get_n_nodes() const { return n_nodes; }
+
+/// Get BDD
+/**
+ * @param i Index of BDD, in the order they were written
+ * 
+ * @return Handle to BDD \a i, valid as long as the snapshot
+ */
+		MappedBdd operator[](unsigned int i) const
+		{
+			assert(i < n_roots);
+
+			return MappedBdd(nodes, roots[i]);
+		}
+	};
+
+/// Evaluate for an assignment
+/**
+ * @param fn_var Predicate giving the value of each variable
+ * 
+ * @return The value of this BDD when v is assigned \a fn_var (v)
+ */
+	template <class VarPredicate>
+	bool MappedBdd::evaluate(VarPredicate fn_var) const
+	{
+		uint32_t node = root;
+
+		while (node >= 2)
+		{
+			node = fn_var(nodes[node].var) ? nodes[node].then_node : nodes[node].else_node;
+		}
+
+		return node == 1;
+	}
+
+	template <class Function>
+	void MappedBdd::for_each_cube(uint32_t node, vector<pair<Domain::Var, bool> >& cube, Function& fn) const
+	{
+		if (node < 2)
+		{
+			if (node == 1) fn((const Cube&)cube);
+			return;
+		}
+
+		cube.push_back(make_pair((Var)nodes[node].var, true));
+		for_each_cube(nodes[node].then_node, cube, fn);
+
+		cube.back().second = false;
+		for_each_cube(nodes[node].else_node, cube, fn);
+
+		cube.pop_back();
+	}
+
+/// Iterate over cubes
+/**
+ * Calls \a fn with each path to the true leaf. Variables not on a path
+ * may have any value.
+ *
+ * @param fn Function taking a const MappedBdd::Cube&
+ */
+	template <class Function>
+	void MappedBdd::for_each_cube(Function fn) const
+	{
+		Cube cube;
+
+		for_each_cube(root, cube, fn);
+	}
+}
+
+#endif /* BDD_SNAPSHOT_H */
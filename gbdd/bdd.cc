@@ -22,9 +22,11 @@
  */
 
 #include <gbdd/bdd.h>
+#include <gbdd/bitset-constraint.h>
 #include <math.h>
 #include <iostream>
 #include <queue>
+#include <string.h>
 
 namespace gbdd
 {
@@ -48,6 +50,11 @@ Bdd* Bdd::Factory::ptr_var(Var v, bool var_v) const
 
 BoolConstraint* Bdd::ptr_convert(const BoolConstraint::Factory& f) const
 {
+	if (dynamic_cast<const BitsetConstraint::Factory*>(&f))
+	{
+		return new BitsetConstraint(vars(), *this);
+	}
+
 	assert(false);
 }
 
@@ -454,6 +461,176 @@ Bdd Bdd::value_follow(Domain::const_iterator current_var,
 }
        
 
+/// Test for constant words
+/**
+ * @param bits Words to test
+ * @param n_words Number of words
+ * @param w Word to compare with
+ * 
+ * @return Whether all words are equal to \a w
+ */
+static bool words_equal(const uint64_t* bits, uint64_t n_words, uint64_t w)
+{
+	uint64_t diff = 0;
+
+	for (uint64_t i = 0;i < n_words;++i)
+	{
+		diff |= bits[i] ^ w;
+	}
+
+	return diff == 0;
+}
+
+/// Construct BDD from truth table
+/**
+ * Bit v of the table, bit v % 64 of word v / 64, is the value of the function
+ * for the value v encoded in \a vs. The BDD is built bottom-up, one variable at
+ * a time from the last variable of \a vs, by pairing the two halves of the
+ * table. A half equal to the other half, or a constant table, is detected by
+ * comparing whole words.
+ *
+ * @param space Space to create BDD in
+ * @param vs Variables to encode values in
+ * @param bits Truth table of 2^|vs| bits, at least one word
+ * 
+ * @return The BDD true for the values encoded in \a vs that are set in \a bits
+ */
+Bdd Bdd::from_truth_table(Space* space, const Domain& vs, const uint64_t* bits)
+{
+	assert(vs.is_finite() && vs.size() < 64);
+
+	vector<Var> vars;
+	for (Domain::const_iterator i = vs.begin();i != vs.end();++i)
+	{
+		vars.push_back(*i);
+	}
+	unsigned int n_vars = vars.size();
+
+	// Drop last variables the table does not depend on, while the halves are whole words
+
+	while (n_vars > 6 && memcmp(bits, bits + ((uint64_t)1 << (n_vars - 7)),
+				    ((uint64_t)1 << (n_vars - 7)) * sizeof(uint64_t)) == 0)
+	{
+		--n_vars;
+	}
+
+	uint64_t n_words = (n_vars > 6) ? ((uint64_t)1 << (n_vars - 6)) : 1;
+	uint64_t first_word_mask = (n_vars >= 6) ? ~(uint64_t)0 : (((uint64_t)1 << (1 << n_vars)) - 1);
+
+	if (n_words == 1 ? (bits[0] & first_word_mask) == 0 : words_equal(bits, n_words, 0))
+		return Bdd(space, false);
+
+	if (n_words == 1 ? (bits[0] & first_word_mask) == first_word_mask : words_equal(bits, n_words, ~(uint64_t)0))
+		return Bdd(space, true);
+
+	// Levels hold referenced BDDs, the backend may collect garbage while building
+
+	Bdd leaves[2] = { Bdd(space, false), Bdd(space, true) };
+	vector<Bdd> level;
+
+	if (n_vars == 0)
+	{
+		level.push_back(leaves[bits[0] & 0x01]);
+	}
+	else
+	{
+		uint64_t half = (uint64_t)1 << (n_vars - 1);
+
+		level.reserve(half);
+
+		for (uint64_t i = 0;i < half;++i)
+		{
+			uint64_t j = i + half;
+			const Bdd& p_then = leaves[(bits[j >> 6] >> (j & 0x3f)) & 0x01];
+			const Bdd& p_else = leaves[(bits[i >> 6] >> (i & 0x3f)) & 0x01];
+
+			level.push_back((p_then == p_else) ? p_then : var_then_else(space, vars[n_vars - 1], p_then, p_else));
+		}
+	}
+
+	// Pair the halves of the level for each variable above
+
+	for (unsigned int var_index = n_vars - 1;var_index > 0;--var_index)
+	{
+		uint64_t half = level.size() / 2;
+
+		if (!equal(level.begin(), level.begin() + half, level.begin() + half))
+		{
+			for (uint64_t i = 0;i < half;++i)
+			{
+				if (!(level[i + half] == level[i]))
+					level[i] = var_then_else(space, vars[var_index - 1], level[i + half], level[i]);
+			}
+		}
+
+		level.erase(level.begin() + half, level.end());
+	}
+
+	return level[0];
+}
+
+void Bdd::to_truth_table(Space::Bdd p, vector<Var>::const_iterator current_var,
+			 const vector<Var>& vars, uint64_t v, uint64_t* bits) const
+{
+	uint64_t base = (uint64_t)1 << (current_var - vars.begin());
+
+	if (space->bdd_is_leaf(p))
+	{
+		if (!space->bdd_leaf_value(p)) return;
+
+		// All values extending v with the remaining variables
+
+		uint64_t n_values = (uint64_t)1 << (vars.end() - current_var);
+
+		for (uint64_t i = 0;i < n_values;++i)
+		{
+			uint64_t value = v + i * base;
+
+			bits[value >> 6] |= (uint64_t)1 << (value & 0x3f);
+		}
+	}
+	else
+	{
+		assert(current_var != vars.end() && space->bdd_var(p) >= *current_var);
+
+		vector<Var>::const_iterator next_var = current_var + 1;
+
+		if (space->bdd_var(p) == *current_var)
+		{
+			to_truth_table(space->bdd_then(p), next_var, vars, v | base, bits);
+			to_truth_table(space->bdd_else(p), next_var, vars, v, bits);
+		}
+		else
+		{
+			to_truth_table(p, next_var, vars, v | base, bits);
+			to_truth_table(p, next_var, vars, v, bits);
+		}
+	}
+}
+
+/// Write truth table
+/**
+ * All variables in the BDD must be in \a vs.
+ *
+ * @param vs Variables to encode values in
+ * @param bits Truth table of 2^|vs| bits, at least one word, see from_truth_table
+ */
+void Bdd::to_truth_table(const Domain& vs, uint64_t* bits) const
+{
+	assert(vs.is_finite() && vs.size() < 64);
+
+	vector<Var> vars;
+	for (Domain::const_iterator i = vs.begin();i != vs.end();++i)
+	{
+		vars.push_back(*i);
+	}
+	uint64_t n_words = (vars.size() > 6) ? ((uint64_t)1 << (vars.size() - 6)) : 1;
+
+	memset(bits, 0, n_words * sizeof(uint64_t));
+
+	to_truth_table(space_bdd, vars.begin(), vars, 0, bits);
+}
+
 /// Membership of value
 /**
  * Tests the assignment of vs by encoding v is a valid
@@ -467,11 +644,29 @@ Bdd Bdd::value_follow(Domain::const_iterator current_var,
 
 bool Bdd::value_member(const Domain& vs, unsigned int v) const
 {
-	Bdd p = value_follow(vs, v);
+	// Follow the nodes in the space, without a Bdd for each step
+
+	Space::Bdd p = space_bdd;
+	Domain::const_iterator current_var = vs.begin();
+
+	while (current_var != vs.end() && !space->bdd_is_leaf(p))
+	{
+		Var var = space->bdd_var(p);
+
+		assert (var >= *current_var);
+
+		if (var == *current_var)
+		{
+			p = (v & 0x01) ? space->bdd_then(p) : space->bdd_else(p);
+		}
+
+		++current_var;
+		v /= 2;
+	}
 
-	assert(p.bdd_is_leaf());
+	assert(space->bdd_is_leaf(p));
 
-	return p.bdd_leaf_value();
+	return space->bdd_leaf_value(p);
 }
 
 /// Membership of value
@@ -783,6 +978,127 @@ bool Bdd::is_true() const
 	return (space_bdd == space->bdd_true());
 }
 
+/// Test for common assignment
+/**
+ * Stops at the first common assignment, without building the conjunction
+ *
+ * @param p2 BDD in the same space
+ * 
+ * @return Whether this BDD AND \a p2 is satisfiable
+ */
+bool Bdd::intersects(const Bdd& p2) const
+{
+	assert(space == p2.space);
+
+	return space->bdd_intersects(space_bdd, p2.space_bdd);
+}
+
+/// Test for implication
+/**
+ * Stops at the first counterexample, without building any BDD
+ *
+ * @param p2 BDD in the same space
+ * 
+ * @return Whether this BDD implies \a p2
+ */
+bool Bdd::leq(const Bdd& p2) const
+{
+	assert(space == p2.space);
+
+	return space->bdd_implies(space_bdd, p2.space_bdd);
+}
+
+/// Restrict to care set
+/**
+ * The result agrees with this BDD on \a care, and is usually smaller.
+ *
+ * @param care BDD in the same space
+ * 
+ * @return This BDD simplified by the restrict operator of Coudert and Madre
+ */
+Bdd Bdd::restrict(const Bdd& care) const
+{
+	assert(space == care.space);
+
+	space->lock_gc();
+
+	Bdd res(space, space->bdd_restrict(space_bdd, care.space_bdd));
+
+	space->unlock_gc();
+
+	return res;
+}
+
+/// Generalized cofactor
+/**
+ * The result agrees with this BDD on \a care.
+ *
+ * @param care BDD in the same space
+ * 
+ * @return The generalized cofactor of this BDD with respect to \a care
+ */
+Bdd Bdd::constrain(const Bdd& care) const
+{
+	assert(space == care.space);
+
+	space->lock_gc();
+
+	Bdd res(space, space->bdd_constrain(space_bdd, care.space_bdd));
+
+	space->unlock_gc();
+
+	return res;
+}
+
+/// Functional composition
+/**
+ * @param v Variable to substitute
+ * @param g BDD in the same space to substitute for \a v
+ * 
+ * @return This BDD with \a g substituted for \a v
+ */
+Bdd Bdd::compose(Var v, const Bdd& g) const
+{
+	assert(space == g.space);
+
+	space->lock_gc();
+
+	Bdd res(space, space->bdd_compose(space_bdd, v, g.space_bdd));
+
+	space->unlock_gc();
+
+	return res;
+}
+
+/// Simultaneous functional composition
+/**
+ * Substitutes all variables at once, so an update such as x := x & y, y := x
+ * refers to the old values of x and y.
+ *
+ * @param fn Mapping from variables to BDDs in the same space
+ * 
+ * @return This BDD with \a fn (v) substituted for every variable v in \a fn
+ */
+Bdd Bdd::compose(const VarBddMap& fn) const
+{
+	Space::VarBddMap space_fn;
+
+	for (VarBddMap::const_iterator i = fn.begin();i != fn.end();++i)
+	{
+		assert(space == i->second.space);
+
+		space_fn[i->first] = i->second.space_bdd;
+	}
+
+	space->lock_gc();
+
+	Bdd res(space, space->bdd_vector_compose(space_bdd, space_fn));
+
+	space->unlock_gc();
+
+	return res;
+}
+
 /// Print a textual representation on a stream	
 /**
  * @param s Stream
@@ -921,6 +1237,11 @@ Bdd* Bdd::ptr_product(const StructureConstraint& b2, bool (*fn)(bool v1, bool v2
 	return new Bdd(bdd_product(*this, (const Bdd&)b2, fn));
 }
 
+Bdd* Bdd::ptr_and_project(const StructureConstraint& b2, Domain vs) const
+{
+	return new Bdd(and_project(*this, (const Bdd&)b2, vs));
+}
+
 Bdd* Bdd::ptr_negate() const
 {
 	return new Bdd(!*this);
@@ -949,6 +1270,280 @@ Bdd Bdd::FiniteVar::operator==(const Bdd::FiniteVar& fv2) const
 	return p;
 }
 
+/// Bits of a number
+/**
+ * @param space BDD space
+ * @param vs Variables encoding the number, or empty for a constant
+ * @param v Constant, 0 if \a vs is not empty
+ * @param width Number of bits, at least the size of \a vs
+ * 
+ * @return BDDs for the \a width lowest bits of the number, lowest first
+ */
+static vector<Bdd> number_bits(Space* space, const Domain& vs, unsigned int v, unsigned int width)
+{
+	assert(vs.size() == 0 || v == 0);
+
+	vector<Bdd> bits;
+
+	for (Domain::const_iterator i = vs.begin();i != vs.end();++i)
+	{
+		bits.push_back(Bdd::var_true(space, *i));
+	}
+
+	while (bits.size() < width)
+	{
+		unsigned int i = bits.size();
+
+		bits.push_back(Bdd(space, i < 32 && ((v >> i) & 0x1)));
+	}
+
+	return bits;
+}
+
+/// Number of bits of a number
+/**
+ * @param vs Variables encoding the number, or empty for a constant
+ * @param v Constant, 0 if \a vs is not empty
+ * 
+ * @return Number of bits needed for any value of the number
+ */
+static unsigned int number_width(const Domain& vs, unsigned int v)
+{
+	unsigned int width = vs.size();
+
+	while (width < 32 && (v >> width) != 0) ++width;
+
+	return width;
+}
+
+/// Comparison of numbers
+/**
+ * Built from the lowest bit, where the result for bits 0..i is the
+ * result for bit i if the bits differ and the result for bits 0..i-1
+ * otherwise.
+ *
+ * @param space BDD space
+ * @param a Bits of first number, lowest first
+ * @param b Bits of second number, of the same size
+ * @param or_equal Whether equal numbers are included
+ * 
+ * @return BDD for a < b, or a <= b if \a or_equal
+ */
+static Bdd number_less(Space* space, const vector<Bdd>& a, const vector<Bdd>& b, bool or_equal)
+{
+	Bdd r(space, or_equal);
+
+	for (unsigned int i = 0;i < a.size();++i)
+	{
+		r = (a[i] & b[i] & r) | ((!a[i]) & (b[i] | r));
+	}
+
+	return r;
+}
+
+/// Sum of numbers
+/**
+ * A ripple-carry adder from the lowest bit. After bit i, \a carry[k] is
+ * true for the assignments where bits 0..i of a + b and r agree and the
+ * carry out of bit i is k.
+ *
+ * @param space BDD space
+ * @param a Bits of first number, lowest first
+ * @param b Bits of second number, of the same size
+ * @param r Bits of result, of the same size
+ * 
+ * @return BDD for a + b == r, without overflow
+ */
+static Bdd number_sum_equal(Space* space, const vector<Bdd>& a, const vector<Bdd>& b, const vector<Bdd>& r)
+{
+	Bdd carry[2] = { Bdd(space, true), Bdd(space, false) };
+
+	for (unsigned int i = 0;i < a.size();++i)
+	{
+		Bdd both = a[i] & b[i];
+		Bdd either = a[i] | b[i];
+		Bdd sum = (a[i] & !b[i]) | ((!a[i]) & b[i]);
+		Bdd sum_ok = (r[i] & sum) | ((!r[i]) & !sum);
+
+		Bdd carry0 = (carry[0] & !both & sum_ok) | (carry[1] & !either & r[i]);
+		Bdd carry1 = (carry[0] & both & !r[i]) | (carry[1] & either & !sum_ok);
+
+		carry[0] = carry0;
+		carry[1] = carry1;
+	}
+
+	return carry[0];
+}
+
+/// Less than constant
+/**
+ * @param v Constant
+ * 
+ * @return BDD for this variable being less than \a v
+ */
+Bdd Bdd::FiniteVar::operator<(unsigned int v) const
+{
+	unsigned int width = number_width(_vs, v);
+
+	return number_less(_space,
+			   number_bits(_space, _vs, 0, width),
+			   number_bits(_space, Domain(), v, width),
+			   false);
+}
+
+/// Less than or equal to constant
+/**
+ * @param v Constant
+ * 
+ * @return BDD for this variable being at most \a v
+ */
+Bdd Bdd::FiniteVar::operator<=(unsigned int v) const
+{
+	unsigned int width = number_width(_vs, v);
+
+	return number_less(_space,
+			   number_bits(_space, _vs, 0, width),
+			   number_bits(_space, Domain(), v, width),
+			   true);
+}
+
+/// Greater than constant
+/**
+ * @param v Constant
+ * 
+ * @return BDD for this variable being greater than \a v
+ */
+Bdd Bdd::FiniteVar::operator>(unsigned int v) const
+{
+	unsigned int width = number_width(_vs, v);
+
+	return number_less(_space,
+			   number_bits(_space, Domain(), v, width),
+			   number_bits(_space, _vs, 0, width),
+			   false);
+}
+
+/// Greater than or equal to constant
+/**
+ * @param v Constant
+ * 
+ * @return BDD for this variable being at least \a v
+ */
+Bdd Bdd::FiniteVar::operator>=(unsigned int v) const
+{
+	unsigned int width = number_width(_vs, v);
+
+	return number_less(_space,
+			   number_bits(_space, Domain(), v, width),
+			   number_bits(_space, _vs, 0, width),
+			   true);
+}
+
+/// Less than variable
+/**
+ * The variables may have different sizes, linear size if they are interleaved
+ *
+ * @param fv2 Variable to compare with
+ * 
+ * @return BDD for this variable being less than \a fv2
+ */
+Bdd Bdd::FiniteVar::operator<(const Bdd::FiniteVar& fv2) const
+{
+	unsigned int width = max(_vs.size(), fv2._vs.size());
+
+	return number_less(_space,
+			   number_bits(_space, _vs, 0, width),
+			   number_bits(_space, fv2._vs, 0, width),
+			   false);
+}
+
+/// Less than or equal to variable
+/**
+ * The variables may have different sizes, linear size if they are interleaved
+ *
+ * @param fv2 Variable to compare with
+ * 
+ * @return BDD for this variable being at most \a fv2
+ */
+Bdd Bdd::FiniteVar::operator<=(const Bdd::FiniteVar& fv2) const
+{
+	unsigned int width = max(_vs.size(), fv2._vs.size());
+
+	return number_less(_space,
+			   number_bits(_space, _vs, 0, width),
+			   number_bits(_space, fv2._vs, 0, width),
+			   true);
+}
+
+/// Sum with constant
+/**
+ * @param v Constant
+ * 
+ * @return The sum of this variable and \a v, to be compared with a number
+ */
+Bdd::FiniteSum Bdd::FiniteVar::operator+(unsigned int v) const
+{
+	return FiniteSum(*this, Domain(), v, false);
+}
+
+/// Sum with variable
+/**
+ * @param fv2 Second variable
+ * 
+ * @return The sum of this variable and \a fv2, to be compared with a number
+ */
+Bdd::FiniteSum Bdd::FiniteVar::operator+(const Bdd::FiniteVar& fv2) const
+{
+	return FiniteSum(*this, fv2._vs, 0, false);
+}
+
+/// Difference with constant
+/**
+ * @param v Constant
+ * 
+ * @return This variable minus \a v, to be compared with a number
+ */
+Bdd::FiniteSum Bdd::FiniteVar::operator-(unsigned int v) const
+{
+	return FiniteSum(*this, Domain(), v, true);
+}
+
+/// Difference with variable
+/**
+ * @param fv2 Second variable
+ * 
+ * @return This variable minus \a fv2, to be compared with a number
+ */
+Bdd::FiniteSum Bdd::FiniteVar::operator-(const Bdd::FiniteVar& fv2) const
+{
+	return FiniteSum(*this, fv2._vs, 0, true);
+}
+
+/// Sum equal to number
+/**
+ * A difference x - y == z is built as z + y == x.
+ *
+ * @param vs Variables encoding the number, or empty for a constant
+ * @param v Constant, 0 if \a vs is not empty
+ * 
+ * @return BDD for the sum or difference being the number
+ */
+Bdd Bdd::FiniteSum::equal(const Domain& vs, unsigned int v) const
+{
+	Space* space = _fv1.get_space();
+	unsigned int width = max(max(number_width(_fv1.get_domain(), 0), number_width(_vs2, _v2)),
+				 number_width(vs, v));
+
+	vector<Bdd> bits1 = number_bits(space, _fv1.get_domain(), 0, width);
+	vector<Bdd> bits2 = number_bits(space, _vs2, _v2, width);
+	vector<Bdd> bits = number_bits(space, vs, v, width);
+
+	return
+		_is_difference ?
+		number_sum_equal(space, bits, bits2, bits1):
+		number_sum_equal(space, bits1, bits2, bits);
+}
+
 }
 
 namespace std
@@ -28,6 +28,7 @@
 #include <gbdd/domain.h>
 #include <gbdd/bool-constraint.h>
 #include <set>
+#include <stdint.h>
 #include <gbdd/sgi_ext.h>
 
 namespace gbdd
@@ -82,6 +83,11 @@ public:
  * 
  */
 	typedef Space::VarMap VarMap;
+/**
+ * Mapping from variables to BDDs substituted for them
+ * 
+ */
+	typedef hash_map<Var, Bdd> VarBddMap;
 
 	Bdd();
 	Bdd(Space* space, bool v = false);
@@ -106,6 +112,8 @@ public:
 		
 		Bdd* ptr_constant(bool v) const;
 		Bdd* ptr_var(Var v, bool var_v) const ;
+
+		Space* get_space() const { return space; }
 	};
 
 	Factory* ptr_factory() const
@@ -173,7 +181,12 @@ public:
 	static unsigned int n_vars_needed(unsigned int n_values);
 	static Bdd value(Space* space, const Domain &vs, unsigned int v);
 	static Bdd value_range(Space* space, const Domain& vs, unsigned int from_v, unsigned int to_v);
+
+	static Bdd from_truth_table(Space* space, const Domain& vs, const uint64_t* bits);
+	void to_truth_table(const Domain& vs, uint64_t* bits) const;
 private:
+	void to_truth_table(Space::Bdd p, vector<Var>::const_iterator current_var,
+			    const vector<Var>& vars, uint64_t v, uint64_t* bits) const;
 	Bdd value_follow(Domain::const_iterator start, 
 			 Domain::const_iterator end, 
 			 unsigned int v) const;
@@ -189,6 +202,8 @@ public:
 
 	static Bdd vars_equal(Space* space, const Domain &vs1, const Domain &vs2);
 
+	class FiniteSum;
+
 	class FiniteVar
 	{
 		Space* _space;
@@ -202,10 +217,53 @@ public:
 		Bdd operator==(unsigned int v) const { return value(_space, _vs, v); }
 		Bdd operator==(const FiniteVar& fv2) const;
 
+		Bdd operator<(unsigned int v) const;
+		Bdd operator<=(unsigned int v) const;
+		Bdd operator>(unsigned int v) const;
+		Bdd operator>=(unsigned int v) const;
+
+		Bdd operator<(const FiniteVar& fv2) const;
+		Bdd operator<=(const FiniteVar& fv2) const;
+		Bdd operator>(const FiniteVar& fv2) const { return fv2 < *this; }
+		Bdd operator>=(const FiniteVar& fv2) const { return fv2 <= *this; }
+
+		FiniteSum operator+(unsigned int v) const;
+		FiniteSum operator+(const FiniteVar& fv2) const;
+		FiniteSum operator-(unsigned int v) const;
+		FiniteSum operator-(const FiniteVar& fv2) const;
+
 		const Domain& get_domain() const { return _vs; }
 		Space* get_space() const { return _space; }
 	};
 
+	/// Sum or difference of a FiniteVar and a constant or another FiniteVar
+	/**
+	 * A FiniteSum is only compared for equality, giving a BDD built as
+	 * a ripple-carry adder from the lowest bit, with a constant number
+	 * of operations per bit. The arithmetic is exact, so x + 3 == y
+	 * does not hold for values of x where the sum does not fit in y,
+	 * and x - 3 == y does not hold for x less than 3.
+	 */
+	class FiniteSum
+	{
+		FiniteVar _fv1;
+		Domain _vs2;
+		unsigned int _v2;
+		bool _is_difference;
+
+		Bdd equal(const Domain& vs, unsigned int v) const;
+	public:
+		FiniteSum(const FiniteVar& fv1, const Domain& vs2, unsigned int v2, bool is_difference):
+			_fv1(fv1),
+			_vs2(vs2),
+			_v2(v2),
+			_is_difference(is_difference)
+			{}
+
+		Bdd operator==(unsigned int v) const { return equal(Domain(), v); }
+		Bdd operator==(const FiniteVar& fv) const { return equal(fv.get_domain(), 0); }
+	};
+
 	class FiniteVars
 	{
 		Space* _space;
@@ -328,18 +386,51 @@ public:
 		return project(fn_var);
 	}
 
-/// Forall projection
+/// Conjunction and OR projection
+/**
+ * Computes the projection without building the conjunction of the two BDDs
+ *
+ * @param p1 First BDD
+ * @param p2 Second BDD
+ * @param fn_var Predicate describing variables to project
+ * 
+ * @return Projection of \a p1 AND \a p2 with OR with respect to all variables v such that fn_var(v)
+ */
+	template <class VarPredicate>
+	static Bdd and_project(const Bdd& p1, const Bdd& p2, VarPredicate fn_var);
+
+/// Synonym for conjunction and OR projection
 /**
+ * @param p1 First BDD
+ * @param p2 Second BDD
  * @param fn_var Predicate describing variables to project
  * 
- * @return !((!p).exists(fn_var)) for p as this BDD
+ * @return Projection of \a p1 AND \a p2 with OR with respect to all variables v such that fn_var(v)
  */
 	template <class VarPredicate>
-	Bdd forall(VarPredicate fn_var) const
+	static Bdd and_exists(const Bdd& p1, const Bdd& p2, VarPredicate fn_var)
 	{
-		return !((!*this).exists(fn_var));
+		return and_project(p1, p2, fn_var);
 	}
 
+/// Forall projection
+/**
+ * @param fn_var Predicate describing variables to project
+ * 
+ * @return Projection of this BDD with AND with respect to all variables v such that fn_var(v)
+ */
+	template <class VarPredicate>
+	Bdd forall(VarPredicate fn_var) const;
+
+/// Unique projection
+/**
+ * @param fn_var Predicate describing variables to project
+ * 
+ * @return Projection of this BDD with XOR with respect to all variables v such that fn_var(v)
+ */
+	template <class VarPredicate>
+	Bdd unique(VarPredicate fn_var) const;
+
 /// Rename according to map
 /**
  * 
@@ -399,6 +490,15 @@ public:
 	bool is_false() const;
 	bool is_true() const;
 
+	bool intersects(const Bdd& p2) const;
+	bool leq(const Bdd& p2) const;
+
+	Bdd restrict(const Bdd& care) const;
+	Bdd constrain(const Bdd& care) const;
+
+	Bdd compose(Var v, const Bdd& g) const;
+	Bdd compose(const VarBddMap& fn) const;
+
 	friend struct hash<Bdd>;
 
 /// Hash value of this BDD
@@ -419,6 +519,7 @@ public:
 	virtual Bdd* ptr_constrain_value(Var v, bool value) const;
 	
 	virtual Bdd* ptr_product(const StructureConstraint& b2, bool (*fn)(bool v1, bool v2)) const;
+	virtual Bdd* ptr_and_project(const StructureConstraint& b2, Domain vs) const;
 	virtual Bdd* ptr_negate() const;
 
 	virtual Bdd* ptr_clone() const;
@@ -461,6 +562,42 @@ Bdd Bdd::project(VarPredicate fn_var, Product fn_prod) const
 	return res;
 }
 
+template <class VarPredicate>
+Bdd Bdd::forall(VarPredicate fn_var) const
+{
+	space->lock_gc();
+
+	Bdd res(space, space->bdd_forall(space_bdd, fn_var));
+
+	space->unlock_gc();
+
+	return res;
+}
+
+template <class VarPredicate>
+Bdd Bdd::unique(VarPredicate fn_var) const
+{
+	space->lock_gc();
+
+	Bdd res(space, space->bdd_unique(space_bdd, fn_var));
+
+	space->unlock_gc();
+
+	return res;
+}
+
+template <class VarPredicate>
+Bdd Bdd::and_project(const Bdd& p1, const Bdd& p2, VarPredicate fn_var)
+{
+	p1.space->lock_gc();
+
+	Bdd res(p1.space, p1.space->bdd_and_project(p1.space_bdd, p2.space_bdd, fn_var));
+
+	p1.space->unlock_gc();
+
+	return res;
+}
+
 
 template <class Product>
 Bdd Bdd::var_product (Space* space, Var v1, Var v2, Product fn)
@@ -0,0 +1,623 @@
+/*
+ * bitset-constraint.cc: 
+ *
+ * Copyright (C) 2004 Marcus Nilsson (marcusn@it.uu.se)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ * 
+ * Authors:
+ *    Marcus Nilsson (marcusn@it.uu.se)
+ */
+
+
+#include <gbdd/bitset-constraint.h>
+#include <algorithm>
+
+namespace gbdd
+{
+
+/// Masks of the bits in a word with bit k of the index cleared
+static const uint64_t low_masks[6] =
+{
+	0x5555555555555555ULL,
+	0x3333333333333333ULL,
+	0x0f0f0f0f0f0f0f0fULL,
+	0x00ff00ff00ff00ffULL,
+	0x0000ffff0000ffffULL,
+	0x00000000ffffffffULL
+};
+
+const unsigned int BitsetConstraint::max_vars;
+
+BitsetConstraint::Factory::~Factory()
+{}
+
+BitsetConstraint* BitsetConstraint::Factory::ptr_constant(bool v) const
+{
+	return new BitsetConstraint(v);
+}
+
+BitsetConstraint* BitsetConstraint::Factory::ptr_var(Var v, bool var_v) const
+{
+	return new BitsetConstraint(BitsetConstraint::var(v, var_v));
+}
+
+/// Number of words in a truth table
+/**
+ * @param n_vars Number of variables
+ * 
+ * @return Number of words of a truth table over \a n_vars variables
+ */
+unsigned int BitsetConstraint::n_words(unsigned int n_vars)
+{
+	return n_vars > 6 ? 1 << (n_vars - 6) : 1;
+}
+
+/// Mask of used bits in the last word of a truth table
+/**
+ * @param n_vars Number of variables
+ * 
+ * @return Mask of the bits of the last word that are part of the table
+ */
+uint64_t BitsetConstraint::last_word_mask(unsigned int n_vars)
+{
+	return n_vars >= 6 ? ~(uint64_t)0 : ((uint64_t)1 << (1 << n_vars)) - 1;
+}
+
+/// Create constant constraint over variables
+/**
+ * @param vars Variables, sorted
+ * @param v Value
+ */
+BitsetConstraint::BitsetConstraint(const vector<Var>& vars, bool v):
+	vars(vars),
+	bits(n_words(vars.size()), v ? last_word_mask(vars.size()) : 0)
+{
+	assert(vars.size() <= max_vars);
+}
+
+/// Create constant constraint
+/**
+ * @param v Value
+ */
+BitsetConstraint::BitsetConstraint(bool v):
+	bits(1, v ? 1 : 0)
+{}
+
+/// Create constraint from truth table
+/**
+ * @param vs Variables, finite and at most max_vars
+ * @param bits Truth table of 2^|vs| bits, at least one word, see gbdd::Bdd::from_truth_table
+ */
+BitsetConstraint::BitsetConstraint(const Domain& vs, const uint64_t* bits)
+{
+	assert(vs.is_finite() && vs.size() <= max_vars);
+
+	for (Domain::const_iterator i = vs.begin();i != vs.end();++i)
+	{
+		vars.push_back(*i);
+	}
+
+	this->bits.assign(bits, bits + n_words(vars.size()));
+	this->bits.back() &= last_word_mask(vars.size());
+}
+
+/// Create constraint from BDD
+/**
+ * @param vs Variables, finite, at most max_vars and including all variables of \a p
+ * @param p BDD
+ */
+BitsetConstraint::BitsetConstraint(const Domain& vs, const Bdd& p)
+{
+	assert(vs.is_finite() && vs.size() <= max_vars);
+
+	for (Domain::const_iterator i = vs.begin();i != vs.end();++i)
+	{
+		vars.push_back(*i);
+	}
+
+	bits.resize(n_words(vars.size()));
+	p.to_truth_table(vs, &bits[0]);
+}
+
+/// Create constraint for variable
+/**
+ * @param v Variable
+ * @param var_v Value of \a v
+ * 
+ * @return Constraint true if \a v is \a var_v
+ */
+BitsetConstraint BitsetConstraint::var(Var v, bool var_v)
+{
+	BitsetConstraint c(vector<Var>(1, v), false);
+
+	c.bits[0] = var_v ? 0x2 : 0x1;
+
+	return c;
+}
+
+/// Get variables
+/**
+ * @return The variables the truth table is over
+ */
+Domain BitsetConstraint::get_vars() const
+{
+	return Domain(set<Var>(vars.begin(), vars.end()));
+}
+
+/// Convert to BDD
+/**
+ * @param space Space of returned BDD
+ * 
+ * @return BDD of the same function
+ */
+Bdd BitsetConstraint::to_bdd(Space* space) const
+{
+	return Bdd::from_truth_table(space, get_vars(), &bits[0]);
+}
+
+BitsetConstraint::Factory* BitsetConstraint::ptr_factory() const
+{
+	return new Factory();
+}
+
+/// Test if part of the table is constant
+/**
+ * @param n_vars Number of variables of the part
+ * @param offset Index of first bit, a multiple of 2^n_vars
+ * 
+ * @return 0 or 1 if the 2^n_vars bits from \a offset are all 0 or 1, otherwise -1
+ */
+int BitsetConstraint::constant_value(unsigned int n_vars, uint64_t offset) const
+{
+	if (n_vars >= 6)
+	{
+		const uint64_t* w = &bits[offset >> 6];
+		const uint64_t* w_end = w + n_words(n_vars);
+		uint64_t v = *w;
+
+		if (v != 0 && v != ~(uint64_t)0) return -1;
+
+		for (;w != w_end;++w)
+		{
+			if (*w != v) return -1;
+		}
+
+		return v != 0;
+	}
+	else
+	{
+		uint64_t mask = last_word_mask(n_vars);
+		uint64_t v = (bits[offset >> 6] >> (offset & 0x3f)) & mask;
+
+		return v == 0 ? 0 : (v == mask ? 1 : -1);
+	}
+}
+
+/// Convert part of the table with another factory
+/**
+ * Shannon expansion on the highest variable of the part
+ *
+ * @param f Factory of returned constraint
+ * @param n_vars Number of variables of the part
+ * @param offset Index of first bit, a multiple of 2^n_vars
+ * 
+ * @return The constraint for the 2^n_vars bits from \a offset
+ */
+BoolConstraint* BitsetConstraint::convert(const BoolConstraint::Factory& f, unsigned int n_vars, uint64_t offset) const
+{
+	int v = constant_value(n_vars, offset);
+
+	if (v != -1) return f.ptr_constant(v == 1);
+
+	Var var = vars[n_vars - 1];
+
+	auto_ptr<BoolConstraint> c_else(convert(f, n_vars - 1, offset));
+	auto_ptr<BoolConstraint> c_then(convert(f, n_vars - 1, offset + ((uint64_t)1 << (n_vars - 1))));
+	auto_ptr<BoolConstraint> var_true(f.ptr_var(var, true));
+	auto_ptr<BoolConstraint> var_false(f.ptr_var(var, false));
+	auto_ptr<StructureConstraint> p_then(var_true->ptr_product(*c_then, fn_and));
+	auto_ptr<StructureConstraint> p_else(var_false->ptr_product(*c_else, fn_and));
+
+	return static_cast<BoolConstraint*>(p_then->ptr_product(*p_else, fn_or));
+}
+
+/// Convert to constraint of another factory
+/**
+ * BDDs are built directly from the truth table, other constraints by
+ * Shannon expansion.
+ *
+ * @param f Factory of returned constraint
+ * 
+ * @return The same constraint created by \a f
+ */
+BoolConstraint* BitsetConstraint::ptr_convert(const BoolConstraint::Factory& f) const
+{
+	const Bdd::Factory* bdd_factory = dynamic_cast<const Bdd::Factory*>(&f);
+
+	if (bdd_factory)
+	{
+		return new Bdd(to_bdd(bdd_factory->get_space()));
+	}
+
+	if (dynamic_cast<const BitsetConstraint::Factory*>(&f))
+	{
+		return ptr_clone();
+	}
+
+	return convert(f, vars.size(), 0);
+}
+
+/// Reorder truth table
+/**
+ * @param to Variables of returned table, sorted
+ * @param positions Position in \a to of each variable of this table
+ * 
+ * @return The same constraint over \a to
+ */
+BitsetConstraint BitsetConstraint::gather(const vector<Var>& to, const vector<unsigned int>& positions) const
+{
+	BitsetConstraint c(to, false);
+	uint64_t n_values = (uint64_t)1 << to.size();
+
+	for (uint64_t v = 0;v < n_values;++v)
+	{
+		uint64_t old_v = 0;
+
+		for (unsigned int j = 0;j < positions.size();++j)
+		{
+			old_v |= ((v >> positions[j]) & 0x1) << j;
+		}
+
+		if ((bits[old_v >> 6] >> (old_v & 0x3f)) & 0x1)
+		{
+			c.bits[v >> 6] |= (uint64_t)1 << (v & 0x3f);
+		}
+	}
+
+	return c;
+}
+
+/// Extend truth table to more variables
+/**
+ * If the new variables are all higher, the table is repeated word by word.
+ *
+ * @param to Variables of returned table, sorted and including the variables of this table
+ * 
+ * @return The same constraint over \a to
+ */
+BitsetConstraint BitsetConstraint::extend(const vector<Var>& to) const
+{
+	if (to == vars) return *this;
+
+	vector<unsigned int> positions;
+	bool is_prefix = true;
+
+	for (unsigned int j = 0, k = 0;j < vars.size();++j)
+	{
+		while (to[k] != vars[j]) ++k;
+
+		positions.push_back(k);
+		is_prefix = is_prefix && k == j;
+	}
+
+	if (!is_prefix) return gather(to, positions);
+
+	BitsetConstraint c(to, false);
+	uint64_t w = bits[0];
+
+	for (uint64_t width = (uint64_t)1 << vars.size();width < 64 && width < ((uint64_t)1 << to.size());width *= 2)
+	{
+		w |= w << width;
+	}
+
+	if (vars.size() < 6)
+	{
+		c.bits.assign(c.bits.size(), w);
+	}
+	else
+	{
+		for (unsigned int i = 0;i < c.bits.size();++i)
+		{
+			c.bits[i] = bits[i % bits.size()];
+		}
+	}
+
+	return c;
+}
+
+/// Project variable
+/**
+ * The two halves of the table for the variable are or:ed, as blocks
+ * of words or, for the six lowest variables, by shifting within each
+ * word.
+ *
+ * @param k Position of variable
+ * 
+ * @return The constraint with the variable projected away
+ */
+BitsetConstraint BitsetConstraint::remove_var(unsigned int k) const
+{
+	vector<Var> new_vars(vars);
+	new_vars.erase(new_vars.begin() + k);
+
+	BitsetConstraint c(new_vars, false);
+
+	if (k >= 6)
+	{
+		unsigned int stride = 1 << (k - 6);
+
+		for (unsigned int i = 0;i < c.bits.size();++i)
+		{
+			unsigned int block = i / stride;
+			unsigned int old_i = block * 2 * stride + i % stride;
+
+			c.bits[i] = bits[old_i] | bits[old_i + stride];
+		}
+	}
+	else
+	{
+		unsigned int shift = 1 << k;
+
+		for (unsigned int i = 0;i < bits.size();++i)
+		{
+			uint64_t w = (bits[i] | (bits[i] >> shift)) & low_masks[k];
+			uint64_t compressed = 0;
+
+			for (unsigned int b = 0;b < 32;++b)
+			{
+				unsigned int old_b = ((b >> k) << (k + 1)) | (b & (shift - 1));
+
+				compressed |= ((w >> old_b) & 0x1) << b;
+			}
+
+			c.bits[i / 2] |= compressed << ((i & 0x1) * 32);
+		}
+	}
+
+	return c;
+}
+
+/// Test if table depends on variable
+/**
+ * @param k Position of variable
+ * 
+ * @return Whether the two halves of the table for the variable differ
+ */
+bool BitsetConstraint::depends_on(unsigned int k) const
+{
+	if (k >= 6)
+	{
+		unsigned int stride = 1 << (k - 6);
+
+		for (unsigned int i = 0;i < bits.size();++i)
+		{
+			if ((i & stride) == 0 && bits[i] != bits[i + stride]) return true;
+		}
+	}
+	else
+	{
+		unsigned int shift = 1 << k;
+
+		for (unsigned int i = 0;i < bits.size();++i)
+		{
+			if (((bits[i] >> shift) ^ bits[i]) & low_masks[k]) return true;
+		}
+	}
+
+	return false;
+}
+
+/// Product of constraints
+/**
+ * @param c1 First constraint
+ * @param c2 Second constraint
+ * @param fn Product function
+ * 
+ * @return The product of \a c1 and \a c2 with \a fn, over the union of their variables
+ */
+BitsetConstraint BitsetConstraint::product(const BitsetConstraint& c1, const BitsetConstraint& c2,
+					   bool (*fn)(bool v1, bool v2))
+{
+	if (c1.vars != c2.vars)
+	{
+		vector<Var> to;
+
+		set_union(c1.vars.begin(), c1.vars.end(), c2.vars.begin(), c2.vars.end(),
+			  back_inserter(to));
+
+		return product(c1.extend(to), c2.extend(to), fn);
+	}
+
+	BitsetConstraint c(c1.vars, false);
+
+	uint64_t m11 = fn(true, true) ? ~(uint64_t)0 : 0;
+	uint64_t m10 = fn(true, false) ? ~(uint64_t)0 : 0;
+	uint64_t m01 = fn(false, true) ? ~(uint64_t)0 : 0;
+	uint64_t m00 = fn(false, false) ? ~(uint64_t)0 : 0;
+
+	const uint64_t* a = &c1.bits[0];
+	const uint64_t* b = &c2.bits[0];
+	uint64_t* r = &c.bits[0];
+
+	for (unsigned int i = 0;i < c.bits.size();++i)
+	{
+		r[i] = (a[i] & b[i] & m11) | (a[i] & ~b[i] & m10) | (~a[i] & b[i] & m01) | (~a[i] & ~b[i] & m00);
+	}
+
+	c.bits.back() &= last_word_mask(c.vars.size());
+
+	return c;
+}
+
+BitsetConstraint BitsetConstraint::operator!() const
+{
+	BitsetConstraint c(vars, false);
+
+	for (unsigned int i = 0;i < bits.size();++i)
+	{
+		c.bits[i] = ~bits[i];
+	}
+
+	c.bits.back() &= last_word_mask(vars.size());
+
+	return c;
+}
+
+BitsetConstraint BitsetConstraint::operator&(const BitsetConstraint& c2) const
+{
+	return product(*this, c2, fn_and);
+}
+
+BitsetConstraint BitsetConstraint::operator|(const BitsetConstraint& c2) const
+{
+	return product(*this, c2, fn_or);
+}
+
+BitsetConstraint BitsetConstraint::operator-(const BitsetConstraint& c2) const
+{
+	return product(*this, c2, fn_minus);
+}
+
+bool BitsetConstraint::operator==(const StructureConstraint& b2) const
+{
+	return *this == (const BitsetConstraint&)b2;
+}
+
+/// Test for equality
+/**
+ * @param c1 First constraint
+ * @param c2 Second constraint
+ * 
+ * @return Whether \a c1 and \a c2 are the same function
+ */
+bool operator==(const BitsetConstraint& c1, const BitsetConstraint& c2)
+{
+	if (c1.vars == c2.vars) return c1.bits == c2.bits;
+
+	vector<BitsetConstraint::Var> to;
+
+	set_union(c1.vars.begin(), c1.vars.end(), c2.vars.begin(), c2.vars.end(),
+		  back_inserter(to));
+
+	return c1.extend(to).bits == c2.extend(to).bits;
+}
+
+/// Get highest variable
+/**
+ * @return The highest variable the constraint depends on, or 0 if none
+ */
+BitsetConstraint::Var BitsetConstraint::highest_var() const
+{
+	for (unsigned int k = vars.size();k > 0;--k)
+	{
+		if (depends_on(k - 1)) return vars[k - 1];
+	}
+
+	return 0;
+}
+
+/// Get lowest variable
+/**
+ * @return The lowest variable the constraint depends on, or 0 if none
+ */
+BitsetConstraint::Var BitsetConstraint::lowest_var() const
+{
+	for (unsigned int k = 0;k < vars.size();++k)
+	{
+		if (depends_on(k)) return vars[k];
+	}
+
+	return 0;
+}
+
+/// Rename variables
+/**
+ * The table is only reordered if \a map does not preserve the order of
+ * the variables.
+ *
+ * @param map Renaming
+ * 
+ * @return The constraint renamed with \a map
+ */
+BitsetConstraint* BitsetConstraint::ptr_rename(VarMap map) const
+{
+	vector<Var> new_vars;
+	bool is_ordered = true;
+
+	for (unsigned int j = 0;j < vars.size();++j)
+	{
+		new_vars.push_back(map(vars[j]));
+		is_ordered = is_ordered && (j == 0 || new_vars[j - 1] < new_vars[j]);
+	}
+
+	if (is_ordered)
+	{
+		BitsetConstraint* c = new BitsetConstraint(*this);
+		c->vars = new_vars;
+
+		return c;
+	}
+
+	vector<Var> to(new_vars);
+	sort(to.begin(), to.end());
+
+	assert(unique(to.begin(), to.end()) == to.end());
+
+	vector<unsigned int> positions;
+	for (unsigned int j = 0;j < new_vars.size();++j)
+	{
+		positions.push_back(lower_bound(to.begin(), to.end(), new_vars[j]) - to.begin());
+	}
+
+	return new BitsetConstraint(gather(to, positions));
+}
+
+BitsetConstraint* BitsetConstraint::ptr_project(Domain vs) const
+{
+	BitsetConstraint c(*this);
+
+	for (unsigned int k = vars.size();k > 0;--k)
+	{
+		if (vs(vars[k - 1]))
+		{
+			c = c.remove_var(k - 1);
+		}
+	}
+
+	return new BitsetConstraint(c);
+}
+
+BitsetConstraint* BitsetConstraint::ptr_constrain_value(Var v, bool value) const
+{
+	return new BitsetConstraint(*this & var(v, value));
+}
+
+BitsetConstraint* BitsetConstraint::ptr_product(const StructureConstraint& b2, bool (*fn)(bool v1, bool v2)) const
+{
+	return new BitsetConstraint(product(*this, (const BitsetConstraint&)b2, fn));
+}
+
+BitsetConstraint* BitsetConstraint::ptr_negate() const
+{
+	return new BitsetConstraint(!*this);
+}
+
+BitsetConstraint* BitsetConstraint::ptr_clone() const
+{
+	return new BitsetConstraint(*this);
+}
+
+}
@@ -0,0 +1,120 @@
+/*
+ * bitset-constraint.h: 
+ *
+ * Copyright (C) 2004 Marcus Nilsson (marcusn@it.uu.se)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ * 
+ * Authors:
+ *    Marcus Nilsson (marcusn@it.uu.se)
+ */
+
+
+#ifndef BITSET_CONSTRAINT_H
+#define BITSET_CONSTRAINT_H
+
+#include <gbdd/bool-constraint.h>
+#include <gbdd/bdd.h>
+#include <stdint.h>
+#include <vector>
+
+namespace gbdd
+{
+	/// Boolean constraint stored as an explicit truth table
+	/**
+	 * The constraint is a truth table over a sorted list of at most
+	 * max_vars variables, bit v of the table being the value for the
+	 * assignment encoded by v as in gbdd::Bdd::from_truth_table. Products
+	 * are computed word by word, and projection combines the two halves
+	 * of the table for each projected variable, so for relations over a
+	 * few small domains no node lookups are done at all.
+	 *
+	 * Operands of a product are first extended to the union of their
+	 * variables. The variables of a constraint are those it was built
+	 * from, the constraint need not depend on all of them.
+	 */
+	class BitsetConstraint : public BoolConstraint
+	{
+	public:
+		/// Maximum number of variables
+		static const unsigned int max_vars = 24;
+
+		class Factory : public BoolConstraint::Factory
+		{
+		public:
+			~Factory();
+
+			BitsetConstraint* ptr_constant(bool v) const;
+			BitsetConstraint* ptr_var(Var v, bool var_v) const;
+		};
+	private:
+		vector<Var> vars;
+		vector<uint64_t> bits;
+
+		BitsetConstraint(const vector<Var>& vars, bool v);
+
+		static unsigned int n_words(unsigned int n_vars);
+		static uint64_t last_word_mask(unsigned int n_vars);
+
+		BitsetConstraint gather(const vector<Var>& to, const vector<unsigned int>& positions) const;
+		BitsetConstraint extend(const vector<Var>& to) const;
+		BitsetConstraint remove_var(unsigned int k) const;
+		bool depends_on(unsigned int k) const;
+		int constant_value(unsigned int n_vars, uint64_t offset) const;
+		BoolConstraint* convert(const BoolConstraint::Factory& f, unsigned int n_vars, uint64_t offset) const;
+	public:
+		explicit BitsetConstraint(bool v);
+		BitsetConstraint(const Domain& vs, const uint64_t* bits);
+		BitsetConstraint(const Domain& vs, const Bdd& p);
+
+		static BitsetConstraint var(Var v, bool var_v);
+
+		Domain get_vars() const;
+
+/// Get truth table
+/**
+ * @return Truth table of 2^|get_vars()| bits, at least one word
+ */
+		const uint64_t* get_bits() const { return &bits[0]; }
+
+		Bdd to_bdd(Space* space) const;
+
+		Factory* ptr_factory() const;
+		BoolConstraint* ptr_convert(const BoolConstraint::Factory& f) const;
+
+		BitsetConstraint operator!() const;
+		BitsetConstraint operator&(const BitsetConstraint& c2) const;
+		BitsetConstraint operator|(const BitsetConstraint& c2) const;
+		BitsetConstraint operator-(const BitsetConstraint& c2) const;
+
+		static BitsetConstraint product(const BitsetConstraint& c1, const BitsetConstraint& c2,
+						bool (*fn)(bool v1, bool v2));
+
+		bool operator==(const StructureConstraint& b2) const;
+		friend bool operator==(const BitsetConstraint& c1, const BitsetConstraint& c2);
+
+		Var highest_var() const;
+		Var lowest_var() const;
+
+		BitsetConstraint* ptr_rename(VarMap map) const;
+		BitsetConstraint* ptr_project(Domain vs) const;
+		BitsetConstraint* ptr_constrain_value(Var v, bool value) const;
+		BitsetConstraint* ptr_product(const StructureConstraint& b2, bool (*fn)(bool v1, bool v2)) const;
+		BitsetConstraint* ptr_negate() const;
+		BitsetConstraint* ptr_clone() const;
+	};
+}
+
+#endif /* BITSET_CONSTRAINT_H */
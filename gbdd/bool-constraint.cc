@@ -22,6 +22,7 @@
  */
 
 #include "bool-constraint.h"
+#include <assert.h>
 
 namespace gbdd
 {
@@ -34,4 +35,37 @@ BoolConstraint* BoolConstraint::Factory::ptr_forall(const BoolConstraint& c) con
 	return c.ptr_convert(*this);
 }
 
+/// Create constraint where two domains are equal
+/**
+ * @param vs1 First domain
+ * @param vs2 Second domain, with as many variables as \a vs1
+ *
+ * @return A constraint where each variable in \a vs1 has the same value as the
+ *         corresponding variable in \a vs2
+ */
+BoolConstraint* BoolConstraint::Factory::ptr_vars_equal(const Domain& vs1, const Domain& vs2) const
+{
+	assert(vs1.is_finite() && vs2.is_finite());
+	assert(vs1.size() == vs2.size());
+
+	auto_ptr<BoolConstraint> res(ptr_constant(true));
+
+	Domain::const_iterator i1 = vs1.begin();
+	Domain::const_iterator i2 = vs2.begin();
+
+	while (i1 != vs1.end())
+	{
+		auto_ptr<BoolConstraint> v1(ptr_var(*i1, true));
+		auto_ptr<BoolConstraint> v2(ptr_var(*i2, true));
+		auto_ptr<StructureConstraint> eq(v1->ptr_product(*v2, fn_iff));
+
+		res.reset(dynamic_cast<BoolConstraint*>(res->ptr_product(*eq, fn_and)));
+
+		++i1;
+		++i2;
+	}
+
+	return res.release();
+}
+
 }
@@ -23,6 +23,7 @@
 
 #include <gbdd/buddy-space.h>
 #include <string>
+#include <iostream>
 
 #ifdef GBDD_WITH_BUDDY
 #include <buddy.h>
@@ -52,6 +53,8 @@ BuddySpace::BuddySpace(unsigned int initial_n_nodes, unsigned int cache_size)
 
 BuddySpace::~BuddySpace()
 {
+	clear_var_sets();
+
 	::bdd_done();
 }
 
@@ -60,6 +63,25 @@ unsigned int BuddySpace::get_n_nodes(void) const
 	return bdd_getnodenum();
 }
 
+void BuddySpace::print_statistics(ostream& os) const
+{
+	bddStat stat;
+	bddCacheStat cache_stat;
+
+	::bdd_stats(&stat);
+	::bdd_cachestats(&cache_stat);
+
+	os << "nodes: " << bdd_getnodenum() << endl;
+	os << "allocated nodes: " << stat.nodenum << endl;
+	os << "produced nodes: " << stat.produced << endl;
+	os << "garbage collections: " << stat.gbcnum << endl;
+	os << "cache size: " << stat.cachesize << endl;
+	os << "cache hits: " << cache_stat.opHit << endl;
+	os << "cache misses: " << cache_stat.opMiss << endl;
+	os << "unique hits: " << cache_stat.uniqueHit << endl;
+	os << "unique misses: " << cache_stat.uniqueMiss << endl;
+}
+
 void BuddySpace::ensure_n_vars(unsigned int n_vars)
 {
 	if (max_vars >= n_vars) return;
@@ -71,6 +93,7 @@ void BuddySpace::ensure_n_vars(unsigned int n_vars)
 
 void BuddySpace::gc()
 {
+	clear_var_sets();
 	::bdd_gbc();
 }
 
@@ -176,48 +199,169 @@ Space::Var BuddySpace::bdd_highest_var(Bdd p)
 	return bdd_highest_var(p, cache);
 }
 
-static bool fn_is_or(Space::ProductFunction& fn)
+/// Encode product function as truth table
+/**
+ * @param fn Product function
+ * 
+ * @return Truth table of \a fn, with (true, true) as the most significant bit
+ */
+static unsigned int fn_to_truth_table(Space::ProductFunction& fn)
 {
-	return fn(true, true) &&
-		fn(true, false) &&
-		fn(false, true) &&
-		fn(true, true);
+	return
+		(fn(true, true) ? 8 : 0) |
+		(fn(true, false) ? 4 : 0) |
+		(fn(false, true) ? 2 : 0) |
+		(fn(false, false) ? 1 : 0);
 }
 
-static Space::Bdd varpredicate_to_set(unsigned int n_vars, Space::VarPredicate& fn_var)
+/// Quantification cube
+/**
+ * The cubes of the last few sets of variables are kept by the space
+ * until the next garbage collection, so repeated quantification over
+ * the same domain does not rebuild its cube.
+ *
+ * @param fn_var Predicate describing variables in the cube
+ *
+ * @return The conjunction of the variables v such that fn_var(v), owned by the space
+ */
+Space::Bdd BuddySpace::var_set(Space::VarPredicate& fn_var)
 {
-	Space::Bdd p = bddtrue.id();
+	vector<Var> vars;
 
-	int i;
-	for (i = n_vars-1;i >= 0;--i)
+	for (Var v = 0;v < max_vars;++v)
 	{
-		if(fn_var(i))
-		{
-			Space::Bdd old_p = p;
+		if (fn_var(v)) vars.push_back(v);
+	}
 
-			bdd_addref(old_p);
+	for (list<pair<vector<Var>, Bdd> >::iterator i = var_sets.begin();i != var_sets.end();++i)
+	{
+		if (i->first == vars)
+		{
+			var_sets.splice(var_sets.begin(), var_sets, i);
 
-			p = bdd_and(p, bdd_ithvar(i));
-			
-			bdd_delref(old_p);
+			return i->second;
 		}
 	}
 
-	bdd_addref(p);
+	Space::Bdd p = bddtrue.id();
+
+	(void)::bdd_addref(p);
+
+	for (vector<Var>::reverse_iterator v = vars.rbegin();v != vars.rend();++v)
+	{
+		Space::Bdd old_p = p;
+
+		p = ::bdd_and(p, ::bdd_ithvar(*v));
+
+		(void)::bdd_addref(p);
+		(void)::bdd_delref(old_p);
+	}
+
+	var_sets.push_front(pair<vector<Var>, Bdd>(vars, p));
+
+	if (var_sets.size() > max_var_sets)
+	{
+		(void)::bdd_delref(var_sets.back().second);
+		var_sets.pop_back();
+	}
 
 	return p;
 }
 
+/// Release all quantification cubes
+void BuddySpace::clear_var_sets()
+{
+	for (list<pair<vector<Var>, Bdd> >::iterator i = var_sets.begin();i != var_sets.end();++i)
+	{
+		(void)::bdd_delref(i->second);
+	}
+
+	var_sets.clear();
+}
+
 
 Space::Bdd BuddySpace::bdd_project(Bdd p, VarPredicate& fn_var, ProductFunction& fn_prod)
 {
-	assert(fn_is_or(fn_prod));
+	unsigned int fn = fn_to_truth_table(fn_prod);
+
+	// BuDDy quantifies with OR, AND and XOR only
+
+	assert(fn == 0xe || fn == 0x8 || fn == 0x6);
+
+	Bdd set = var_set(fn_var);
+
+	Bdd res;
+
+	switch (fn)
+	{
+	case 0x8:
+		res = ::bdd_forall(p, set);
+		break;
+	case 0x6:
+		res = ::bdd_unique(p, set);
+		break;
+	default:
+		res = bdd_exist(p, set);
+	}
+
+	return res;
+}
+
+Space::Bdd BuddySpace::bdd_forall(Bdd p, VarPredicate& fn_var)
+{
+	Bdd set = var_set(fn_var);
 
-	Bdd set = varpredicate_to_set(max_vars, fn_var);
+	return ::bdd_forall(p, set);
+}
+
+Space::Bdd BuddySpace::bdd_unique(Bdd p, VarPredicate& fn_var)
+{
+	Bdd set = var_set(fn_var);
 
-	Bdd res = bdd_exist(p, set);
+	return ::bdd_unique(p, set);
+}
+
+Space::Bdd BuddySpace::bdd_and_project(Bdd p, Bdd q, VarPredicate& fn_var)
+{
+	Bdd set = var_set(fn_var);
+
+	return bdd_appex(p, q, bddop_and, set);
+}
 
-	bdd_delref(set);
+Space::Bdd BuddySpace::bdd_restrict(Bdd p, Bdd care)
+{
+	// BuDDy calls the restrict operator of Coudert and Madre simplify
+
+	return ::bdd_simplify(p, care);
+}
+
+Space::Bdd BuddySpace::bdd_constrain(Bdd p, Bdd care)
+{
+	return ::bdd_constrain(p, care);
+}
+
+Space::Bdd BuddySpace::bdd_compose(Bdd p, Var v, Bdd g)
+{
+	ensure_n_vars(v + 1);
+
+	return ::bdd_compose(p, g, v);
+}
+
+Space::Bdd BuddySpace::bdd_vector_compose(Bdd p, const VarBddMap& fn)
+{
+	bddPair* pair = bdd_newpair();
+
+	VarBddMap::const_iterator i;
+	for (i = fn.begin();i != fn.end();++i)
+	{
+		ensure_n_vars(i->first + 1);
+
+		bdd_setbddpair(pair, i->first, i->second);
+	}
+
+	Bdd res = bdd_veccompose(p, pair);
+
+	bdd_freepair(pair);
 
 	return res;
 }
@@ -242,46 +386,46 @@ Space::Bdd BuddySpace::bdd_rename(Bdd p, const VarMap& fn)
 	return res;
 }
 
+/*
+ * Functions that do not depend on both arguments have no BuDDy
+ * operator, and are handled in bdd_product
+ */
 static int op_table[] =
 {
 	/* (true, true) (true, false) (false, true) (false, false) */
 	-1, /* 0000 */
-        -1, /* 0001 */
-	-1, /* 0010 */
+        bddop_nor, /* 0001 */
+	bddop_less, /* 0010 */
 	-1, /* 0011 */
 	bddop_diff, /* 0100 */
 	-1, /* 0101 */
-	-1, /* 0110 */
-	-1, /* 0111 */
+	bddop_xor, /* 0110 */
+	bddop_nand, /* 0111 */
 	bddop_and, /* 1000 */
 	bddop_biimp, /* 1001 */
 	-1, /* 1010 */
 	bddop_imp, /* 1011 */
 	-1, /* 1100 */
-	-1, /* 1101 */
+	bddop_invimp, /* 1101 */
 	bddop_or, /* 1110 */
 	-1, /* 1111 */
 };
 
-static int fn_to_op(Space::ProductFunction& fn)
-{
-	unsigned int index = 0;
-
-	if (fn(true, true)) index |= 0x08;
-	if (fn(true, false)) index |= 0x04;
-	if (fn(false, true)) index |= 0x02;
-	if (fn(false, false)) index |= 0x01;
-
-	return op_table[index];
-}
-
 Space::Bdd BuddySpace::bdd_product(Bdd p, Bdd q, ProductFunction& fn)
 {
-	int op = fn_to_op(fn);
+	unsigned int index = fn_to_truth_table(fn);
 
-	assert(op != -1);
+	switch (index)
+	{
+	case 0x0: return bdd_false();
+	case 0x3: return bdd_not(p);
+	case 0x5: return bdd_not(q);
+	case 0xa: return q;
+	case 0xc: return p;
+	case 0xf: return bdd_true();
+	}
 
-	return bdd_apply(p, q, op);
+	return bdd_apply(p, q, op_table[index]);
 }
 
 Space::Bdd BuddySpace::bdd_product(Bdd p, UnaryProductFunction& fn)
@@ -35,6 +35,7 @@ namespace gbdd
 CuddSpace::CuddSpace()
 {
 	max_vars = 2048;
+	n_vars = 0;
 	manager = Cudd_Init(max_vars, 0, CUDD_UNIQUE_SLOTS, CUDD_CACHE_SLOTS, 0);
 }
 
@@ -42,25 +43,39 @@ CuddSpace::CuddSpace()
 
 CuddSpace::~CuddSpace()
 {
+	clear_var_sets();
+
 	Cudd_Quit(manager);
 }
 
 unsigned int CuddSpace::get_n_nodes(void) const
 {
-	return 0;
+	return Cudd_ReadNodeCount(manager);
+}
+
+void CuddSpace::print_statistics(ostream& os) const
+{
+	os << "nodes: " << Cudd_ReadNodeCount(manager) << endl;
+	os << "peak nodes: " << Cudd_ReadPeakNodeCount(manager) << endl;
+	os << "garbage collections: " << Cudd_ReadGarbageCollections(manager) << endl;
+	os << "cache slots: " << Cudd_ReadCacheSlots(manager) << endl;
+	os << "cache lookups: " << Cudd_ReadCacheLookUps(manager) << endl;
+	os << "cache hits: " << Cudd_ReadCacheHits(manager) << endl;
 }
 
 void CuddSpace::ensure_n_vars(unsigned int n_vars)
 {
-	if (max_vars >= n_vars) return;
+	assert(n_vars <= max_vars);
 
-	assert(false);
+	// Variables above the highest one used are never quantified
+
+	if (n_vars > this->n_vars) this->n_vars = n_vars;
 }
 
 
 void CuddSpace::gc()
 {
-	return;
+	clear_var_sets();
 }
 
 void CuddSpace::bdd_ref(Bdd p)
@@ -170,50 +185,194 @@ Space::Var CuddSpace::bdd_highest_var(Bdd p)
 	return bdd_highest_var(p, cache);
 }
 
-static bool fn_is_or(Space::ProductFunction& fn)
+/// Encode product function as truth table
+/**
+ * @param fn Product function
+ * 
+ * @return Truth table of \a fn, with (true, true) as the most significant bit
+ */
+static unsigned int fn_to_truth_table(Space::ProductFunction& fn)
 {
-	return fn(true, true) &&
-		fn(true, false) &&
-		fn(false, true) &&
-		fn(true, true);
+	return
+		(fn(true, true) ? 8 : 0) |
+		(fn(true, false) ? 4 : 0) |
+		(fn(false, true) ? 2 : 0) |
+		(fn(false, false) ? 1 : 0);
 }
 
-Space::Bdd CuddSpace::varpredicate_to_set(unsigned int n_vars, Space::VarPredicate& fn_var)
+/// Quantification cube
+/**
+ * The cubes of the last few sets of variables are kept by the space
+ * until the next garbage collection, so repeated quantification over
+ * the same domain only evaluates the predicate on the variables in use.
+ *
+ * @param fn_var Predicate describing variables in the cube
+ *
+ * @return The conjunction of the variables v such that fn_var(v), owned by the space
+ */
+Space::Bdd CuddSpace::var_set(Space::VarPredicate& fn_var)
 {
-	Space::Bdd p = bdd_leaf(true);
+	vector<Var> vars;
 
-	int i;
-	for (i = n_vars-1;i >= 0;--i)
+	for (Var v = 0;v < n_vars;++v)
 	{
-		if(fn_var(i))
-		{
-			Space::Bdd old_p = p;
+		if (fn_var(v)) vars.push_back(v);
+	}
 
-			bdd_ref(old_p);
+	for (list<pair<vector<Var>, Bdd> >::iterator i = var_sets.begin();i != var_sets.end();++i)
+	{
+		if (i->first == vars)
+		{
+			var_sets.splice(var_sets.begin(), var_sets, i);
 
-			p = (Bdd)Cudd_bddAnd(manager, (DdNode*)p, (DdNode*)bdd_var_true(i));
-			
-			bdd_unref(old_p);
+			return i->second;
 		}
 	}
 
+	Space::Bdd p = bdd_leaf(true);
+
 	bdd_ref(p);
 
+	for (vector<Var>::reverse_iterator v = vars.rbegin();v != vars.rend();++v)
+	{
+		Space::Bdd old_p = p;
+
+		p = (Bdd)Cudd_bddAnd(manager, (DdNode*)p, (DdNode*)bdd_var_true(*v));
+
+		bdd_ref(p);
+		bdd_unref(old_p);
+	}
+
+	var_sets.push_front(pair<vector<Var>, Bdd>(vars, p));
+
+	if (var_sets.size() > max_var_sets)
+	{
+		bdd_unref(var_sets.back().second);
+		var_sets.pop_back();
+	}
+
 	return p;
 }
 
+/// Release all quantification cubes
+void CuddSpace::clear_var_sets()
+{
+	for (list<pair<vector<Var>, Bdd> >::iterator i = var_sets.begin();i != var_sets.end();++i)
+	{
+		bdd_unref(i->second);
+	}
+
+	var_sets.clear();
+}
+
 
 Space::Bdd CuddSpace::bdd_project(Bdd p, VarPredicate& fn_var, ProductFunction& fn_prod)
 {
-	assert(fn_is_or(fn_prod));
+	unsigned int fn = fn_to_truth_table(fn_prod);
+
+	// CUDD quantifies with OR and AND, XOR is done variable by variable
+
+	assert(fn == 0xe || fn == 0x8 || fn == 0x6);
+
+	if (fn == 0x8) return bdd_forall(p, fn_var);
+	if (fn == 0x6) return bdd_unique(p, fn_var);
+
+	DdNode* set = (DdNode*)var_set(fn_var);
+
+	return (Bdd)Cudd_bddExistAbstract(manager, (DdNode*)p, set);
+}
+
+Space::Bdd CuddSpace::bdd_forall(Bdd p, VarPredicate& fn_var)
+{
+	DdNode* set = (DdNode*)var_set(fn_var);
+
+	return (Bdd)Cudd_bddUnivAbstract(manager, (DdNode*)p, set);
+}
+
+Space::Bdd CuddSpace::bdd_unique(Bdd p, VarPredicate& fn_var)
+{
+	// Cudd_bddXorExistAbstract quantifies existentially, so take the
+	// boolean difference p[v := true] XOR p[v := false] for each variable
+
+	DdNode* res = (DdNode*)p;
+
+	Cudd_Ref(res);
+
+	for (Var v = 0;v < n_vars;++v)
+	{
+		if (fn_var(v))
+		{
+			DdNode* old_res = res;
+
+			res = Cudd_bddBooleanDiff(manager, old_res, v);
+			Cudd_Ref(res);
+
+			Cudd_RecursiveDeref(manager, old_res);
+		}
+	}
+
+	Cudd_Deref(res);
+
+	return (Bdd)res;
+}
+
+Space::Bdd CuddSpace::bdd_and_project(Bdd p, Bdd q, VarPredicate& fn_var)
+{
+	DdNode* set = (DdNode*)var_set(fn_var);
+
+	return (Bdd)Cudd_bddAndAbstract(manager, (DdNode*)p, (DdNode*)q, set);
+}
 
-	DdNode* set = (DdNode*)varpredicate_to_set(max_vars, fn_var);
+bool CuddSpace::bdd_intersects(Bdd p, Bdd q)
+{
+	return !Cudd_bddLeq(manager, (DdNode*)p, Cudd_Not((DdNode*)q));
+}
 
-	Bdd res = (Bdd)Cudd_bddExistAbstract(manager, (DdNode*)p, set);
+bool CuddSpace::bdd_implies(Bdd p, Bdd q)
+{
+	return Cudd_bddLeq(manager, (DdNode*)p, (DdNode*)q);
+}
 
-	bdd_unref((Bdd)set);
+Space::Bdd CuddSpace::bdd_restrict(Bdd p, Bdd care)
+{
+	return (Bdd)Cudd_bddRestrict(manager, (DdNode*)p, (DdNode*)care);
+}
+
+Space::Bdd CuddSpace::bdd_constrain(Bdd p, Bdd care)
+{
+	return (Bdd)Cudd_bddConstrain(manager, (DdNode*)p, (DdNode*)care);
+}
+
+Space::Bdd CuddSpace::bdd_compose(Bdd p, Var v, Bdd g)
+{
+	ensure_n_vars(v + 1);
 
-	return res;
+	return (Bdd)Cudd_bddCompose(manager, (DdNode*)p, (DdNode*)g, v);
+}
+
+Space::Bdd CuddSpace::bdd_vector_compose(Bdd p, const VarBddMap& fn)
+{
+	VarBddMap::const_iterator i;
+	for (i = fn.begin();i != fn.end();++i)
+	{
+		ensure_n_vars(i->first + 1);
+	}
+
+	// CUDD expects a BDD for every variable, variables not substituted map to themselves
+
+	vector<DdNode*> substitution(Cudd_ReadSize(manager));
+
+	for (unsigned int v = 0;v < substitution.size();++v)
+	{
+		substitution[v] = Cudd_bddIthVar(manager, v);
+	}
+
+	for (i = fn.begin();i != fn.end();++i)
+	{
+		substitution[i->first] = (DdNode*)i->second;
+	}
+
+	return (Bdd)Cudd_bddVectorCompose(manager, (DdNode*)p, &substitution[0]);
 }
 
 Space::Bdd CuddSpace::bdd_rename(Bdd p, const VarMap& fn)
@@ -251,51 +410,70 @@ static DdNode* op_imp(DdManager* manager, DdNode* x, DdNode* y)
 	return Cudd_bddOr(manager, Cudd_Not(x), y);
 }
 
-static DdNode* op_biimp(DdManager* manager, DdNode* x, DdNode* y)
+static DdNode* op_less(DdManager* manager, DdNode* x, DdNode* y)
+{
+	return Cudd_bddAnd(manager, Cudd_Not(x), y);
+}
+
+static DdNode* op_invimp(DdManager* manager, DdNode* x, DdNode* y)
+{
+	return Cudd_bddOr(manager, x, Cudd_Not(y));
+}
+
+static DdNode* op_false(DdManager* manager, DdNode* x, DdNode* y)
+{
+	return Cudd_ReadLogicZero(manager);
+}
+
+static DdNode* op_true(DdManager* manager, DdNode* x, DdNode* y)
+{
+	return Cudd_ReadOne(manager);
+}
+
+static DdNode* op_x(DdManager* manager, DdNode* x, DdNode* y)
 {
-	return Cudd_Not(Cudd_bddXor(manager, x, y));
+	return x;
 }
 
+static DdNode* op_y(DdManager* manager, DdNode* x, DdNode* y)
+{
+	return y;
+}
 
+static DdNode* op_not_x(DdManager* manager, DdNode* x, DdNode* y)
+{
+	return Cudd_Not(x);
+}
+
+static DdNode* op_not_y(DdManager* manager, DdNode* x, DdNode* y)
+{
+	return Cudd_Not(y);
+}
 
 static OpFunction op_table[] =
 {
 	/* (true, true) (true, false) (false, true) (false, false) */
-	NULL, /* 0000 */
-        NULL, /* 0001 */
-	NULL, /* 0010 */
-	NULL, /* 0011 */
+	op_false, /* 0000 */
+        Cudd_bddNor, /* 0001 */
+	op_less, /* 0010 */
+	op_not_x, /* 0011 */
 	op_diff, /* 0100 */
-	NULL, /* 0101 */
-	NULL, /* 0110 */
-	NULL, /* 0111 */
+	op_not_y, /* 0101 */
+	Cudd_bddXor, /* 0110 */
+	Cudd_bddNand, /* 0111 */
 	Cudd_bddAnd, /* 1000 */
-	op_biimp, /* 1001 */
-	NULL, /* 1010 */
+	Cudd_bddXnor, /* 1001 */
+	op_y, /* 1010 */
 	op_imp, /* 1011 */
-	NULL, /* 1100 */
-	NULL, /* 1101 */
+	op_x, /* 1100 */
+	op_invimp, /* 1101 */
 	Cudd_bddOr, /* 1110 */
-	NULL, /* 1111 */
+	op_true, /* 1111 */
 };
 
-static OpFunction fn_to_op(Space::ProductFunction& fn)
-{
-	unsigned int index = 0;
-
-	if (fn(true, true)) index |= 0x08;
-	if (fn(true, false)) index |= 0x04;
-	if (fn(false, true)) index |= 0x02;
-	if (fn(false, false)) index |= 0x01;
-
-	return op_table[index];
-}
-
 Space::Bdd CuddSpace::bdd_product(Bdd p, Bdd q, ProductFunction& fn)
 {
-	OpFunction op = fn_to_op(fn);
-
-	assert(op != NULL);
+	OpFunction op = op_table[fn_to_truth_table(fn)];
 
 	return (Bdd)op(manager, (DdNode*)p, (DdNode*)q);
 }
@@ -303,11 +481,11 @@ Space::Bdd CuddSpace::bdd_product(Bdd p, Bdd q, ProductFunction& fn)
 Space::Bdd CuddSpace::bdd_product(Bdd p, UnaryProductFunction& fn)
 {
 	if (fn(true) && fn(false)) return bdd_leaf(true);
-	if (!fn(true) && !fn(false)) return bdd_leaf(true);
+	if (!fn(true) && !fn(false)) return bdd_leaf(false);
 
 	if (fn(true) && !fn(false)) return p;
 
-	return (Bdd)Cudd_Not(p);
+	return (Bdd)Cudd_Not((DdNode*)p);
 }
 
 void CuddSpace::bdd_print(ostream &os, Bdd p)
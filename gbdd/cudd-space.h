@@ -28,6 +28,7 @@
 #ifdef GBDD_WITH_CUDD
 #include <gbdd/space.h>
 #include <stdio.h>
+#include <list>
 
 extern "C" {
 #include <cudd.h>
@@ -39,12 +40,20 @@ namespace gbdd
 	class CuddSpace : public Space
 	{
 		unsigned int max_vars;
+		unsigned int n_vars;
 
 		DdManager* manager;
 
+		/// Recently used quantification cubes and their variables, most recent first
+		list<pair<vector<Var>, Bdd> > var_sets;
+
+		/// Maximum number of quantification cubes kept
+		static const unsigned int max_var_sets = 16;
+
 		void ensure_n_vars(unsigned int n_vars);
 		Var bdd_highest_var(Bdd p, hash_set<Bdd>& cache);
-		Bdd varpredicate_to_set(unsigned int n_vars, Space::VarPredicate& fn_var);
+		Bdd var_set(Space::VarPredicate& fn_var);
+		void clear_var_sets();
 	public:
 		CuddSpace();
 		virtual ~CuddSpace();
@@ -72,10 +81,20 @@ namespace gbdd
 		Bdd bdd_rename(Bdd p, const VarMap& fn);
 		Bdd bdd_product(Bdd p, Bdd q, ProductFunction& fn);
 		Bdd bdd_product(Bdd p, UnaryProductFunction& fn);
+		Bdd bdd_and_project(Bdd p, Bdd q, VarPredicate& fn_var);
+		Bdd bdd_forall(Bdd p, VarPredicate& fn_var);
+		Bdd bdd_unique(Bdd p, VarPredicate& fn_var);
+		bool bdd_intersects(Bdd p, Bdd q);
+		bool bdd_implies(Bdd p, Bdd q);
+		Bdd bdd_restrict(Bdd p, Bdd care);
+		Bdd bdd_constrain(Bdd p, Bdd care);
+		Bdd bdd_compose(Bdd p, Var v, Bdd g);
+		Bdd bdd_vector_compose(Bdd p, const VarBddMap& fn);
 		
 		void bdd_print(ostream &os, Bdd p);
 
 		unsigned int get_n_nodes(void) const;
+		void print_statistics(ostream& os) const;
 	};
 }	
 
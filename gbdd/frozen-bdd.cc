@@ -0,0 +1,108 @@
+/*
+ * frozen-bdd.cc: 
+ *
+ * Copyright (C) 2004 Marcus Nilsson (marcusn@it.uu.se)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ * 
+ * Authors:
+ *    Marcus Nilsson (marcusn@it.uu.se)
+ */
+
+
+#include <gbdd/frozen-bdd.h>
+
+namespace gbdd
+{
+
+/// Copy node and its descendants
+/**
+ * Nodes are numbered before their children, giving a depth first layout
+ *
+ * @param p BDD to copy
+ * @param bits Domain and bit of each variable
+ * @param ids Index of nodes copied so far
+ * 
+ * @return Index of \a p
+ */
+uint32_t FrozenBdd::add_node(const Bdd& p, const hash_map<Domain::Var, uint32_t>& bits,
+			     hash_map<Bdd, uint32_t>& ids)
+{
+	if (p.bdd_is_leaf()) return p.bdd_leaf_value() ? 1 : 0;
+
+	hash_map<Bdd, uint32_t>::const_iterator i = ids.find(p);
+
+	if (i != ids.end()) return i->second;
+
+	hash_map<Domain::Var, uint32_t>::const_iterator bit = bits.find(p.bdd_var());
+
+	assert(bit != bits.end());
+
+	uint32_t id = nodes.size();
+
+	ids[p] = id;
+	nodes.push_back(Node());
+	nodes[id].bit = bit->second;
+
+	uint32_t then_id = add_node(p.bdd_then(), bits, ids);
+	uint32_t else_id = add_node(p.bdd_else(), bits, ids);
+
+	nodes[id].child[1] = then_id;
+	nodes[id].child[0] = else_id;
+
+	return id;
+}
+
+/// Constructor
+/**
+ * @param ds Domains of the tuples, see gbdd::FrozenBdd
+ * @param p BDD over \a ds
+ */
+FrozenBdd::FrozenBdd(const Domains& ds, const Bdd& p):
+	nodes(2)
+{
+	hash_map<Domain::Var, uint32_t> bits;
+
+	for (unsigned int i = 0;i < ds.size();++i)
+	{
+		assert(ds[i].is_finite() && ds[i].size() <= 32);
+
+		high_masks.push_back(ds[i].size() < 32 ? ~((1U << ds[i].size()) - 1) : 0);
+
+		uint32_t bit = i << 5;
+		for (Domain::const_iterator j = ds[i].begin();j != ds[i].end();++j)
+		{
+			assert(bits.find(*j) == bits.end());
+
+			bits[*j] = bit++;
+		}
+	}
+
+	hash_map<Bdd, uint32_t> ids;
+
+	root = add_node(p, bits, ids);
+}
+
+/// Constructor
+/**
+ * @param vs Domain of the values, see gbdd::FrozenBdd
+ * @param p BDD over \a vs
+ */
+FrozenBdd::FrozenBdd(const Domain& vs, const Bdd& p)
+{
+	*this = FrozenBdd(Domains(vs), p);
+}
+
+}
@@ -0,0 +1,131 @@
+/*
+ * frozen-bdd.h: 
+ *
+ * Copyright (C) 2004 Marcus Nilsson (marcusn@it.uu.se)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ * 
+ * Authors:
+ *    Marcus Nilsson (marcusn@it.uu.se)
+ */
+
+
+#ifndef FROZEN_BDD_H
+#define FROZEN_BDD_H
+
+#include <gbdd/bdd.h>
+#include <stdint.h>
+#include <vector>
+
+namespace gbdd
+{
+	/// Read-only BDD laid out for fast membership queries
+	/**
+	 * The nodes reachable from the BDD are copied to one array in
+	 * depth first order, with 32-bit indices of their children, so a
+	 * lookup follows a path through mostly adjacent nodes. Each node
+	 * stores the domain and bit of its variable instead of the
+	 * variable, and a lookup selects the next node by the bit of the
+	 * value, without refcounting, virtual calls or variable
+	 * comparisons.
+	 *
+	 * The domains must be finite, disjoint, have at most 32 variables
+	 * each, and include all variables of the BDD.
+	 */
+	class FrozenBdd
+	{
+		class Node
+		{
+		public:
+			/// Domain index times 32 plus bit position in domain
+			uint32_t bit;
+			/// Else and then node
+			uint32_t child[2];
+		};
+
+		vector<Node> nodes;
+		uint32_t root;
+
+		/// Bits above the width of each domain
+		vector<uint32_t> high_masks;
+
+		uint32_t add_node(const Bdd& p, const hash_map<Domain::Var, uint32_t>& bits,
+				  hash_map<Bdd, uint32_t>& ids);
+	public:
+		FrozenBdd(const Domains& ds, const Bdd& p);
+		FrozenBdd(const Domain& vs, const Bdd& p);
+
+/// Membership of value
+/**
+ * @param v Value, encoded in the only domain
+ * 
+ * @return Whether \a v is a member, false if \a v does not fit in the domain
+ */
+		bool member(uint32_t v) const
+		{
+			if (v & high_masks[0]) return false;
+
+			uint32_t node = root;
+
+			while (node >= 2)
+			{
+				node = nodes[node].child[(v >> nodes[node].bit) & 0x01];
+			}
+
+			return node == 1;
+		}
+
+/// Membership of tuple
+/**
+ * @param values Value for each domain
+ * 
+ * @return Whether the tuple is a member, false if some value does not fit in its domain
+ */
+		bool member(const uint32_t* values) const
+		{
+			for (unsigned int i = 0;i < high_masks.size();++i)
+			{
+				if (values[i] & high_masks[i]) return false;
+			}
+
+			uint32_t node = root;
+
+			while (node >= 2)
+			{
+				uint32_t bit = nodes[node].bit;
+
+				node = nodes[node].child[(values[bit >> 5] >> (bit & 0x1f)) & 0x01];
+			}
+
+			return node == 1;
+		}
+
+/// Membership of tuple
+/**
+ * @param values Value for each domain
+ * 
+ * @return Whether the tuple is a member
+ */
+		bool member(const vector<uint32_t>& values) const { return member(&values[0]); }
+
+/// Get number of nodes
+/**
+ * @return Number of nodes, including the leaves
+ */
+		unsigned int get_n_nodes() const { return nodes.size(); }
+	};
+}
+
+#endif /* FROZEN_BDD_H */
@@ -0,0 +1,488 @@
+/*
+ * gbdd-bench.cc: Benchmarks of BDD and relation workloads
+ *
+ * Copyright (C) 2004 Marcus Nilsson (marcusn@it.uu.se)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Authors:
+ *    Marcus Nilsson (marcusn@it.uu.se)
+ */
+
+/*
+ * Every workload is run on every compiled space in a child process of its own,
+ * so that the memory high-water mark reported is that of the workload alone.
+ * Each run prints one line of JSON on standard output:
+ *
+ * {"space":"gspace","workload":"queens","size":8,"seconds":0.12,"peak_nodes":1234,"max_rss_kb":5678,"result":92}
+ *
+ * The workloads are deterministic, so results can be compared between spaces
+ * and between versions of the library. The default sizes are small enough for
+ * GSpace to finish in seconds, use -w with -n to run a larger instance of one
+ * workload.
+ */
+
+#include <gbdd/gbdd.h>
+#include <gbdd/cudd-space.h>
+#include <iostream>
+#include <string.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/time.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <assert.h>
+
+using namespace gbdd;
+
+typedef Space::Var Var;
+
+/// State of one benchmark run
+class Run
+{
+	Space* space;
+	unsigned int peak_nodes;
+public:
+	Run(Space* space) : space(space), peak_nodes(0) {}
+
+	Space* get_space() const { return space; }
+
+	/// Record current number of nodes
+	void sample()
+	{
+		unsigned int n_nodes = space->get_n_nodes();
+
+		if (n_nodes > peak_nodes) peak_nodes = n_nodes;
+	}
+
+	unsigned int get_peak_nodes() const { return peak_nodes; }
+};
+
+/*
+ * Workloads, each returning a number characterizing its result
+ */
+
+static bool fn_xor(bool v1, bool v2) { return v1 != v2; }
+
+static Bdd bdd_xor(const Bdd& p, const Bdd& q)
+{
+	return Bdd::bdd_product(p, q, fn_xor);
+}
+
+static Bdd bdd_iff(const Bdd& p, const Bdd& q)
+{
+	return Bdd::bdd_product(p, q, Bdd::fn_iff);
+}
+
+/// N-queens on an n times n board, returns the number of solutions
+static unsigned long int bench_queens(Run& run, unsigned int n)
+{
+	Space* space = run.get_space();
+	Bdd::Vars x(space);
+	Bdd board(space, true);
+
+	for (unsigned int i = 0;i < n;++i)
+	{
+		Bdd row(space, false);
+
+		for (unsigned int j = 0;j < n;++j)
+		{
+			row |= x[i * n + j];
+		}
+
+		board &= row;
+	}
+
+	for (unsigned int i = 0;i < n;++i)
+	{
+		for (unsigned int j = 0;j < n;++j)
+		{
+			Bdd others(space, true);
+
+			for (unsigned int k = 0;k < n;++k)
+			{
+				if (k != j) others &= !x[i * n + k];
+				if (k != i) others &= !x[k * n + j];
+
+				int d = (int)k - (int)i;
+
+				if (k != i && (int)j + d >= 0 && (int)j + d < (int)n) others &= !x[k * n + j + d];
+				if (k != i && (int)j - d >= 0 && (int)j - d < (int)n) others &= !x[k * n + j - d];
+			}
+
+			board &= Bdd::bdd_product(x[i * n + j], others, Bdd::fn_implies);
+			run.sample();
+		}
+	}
+
+	return board.n_assignments(Domain(0, n * n));
+}
+
+/// Relation s = a + b mod 2^n_bits, with the bits of a, b and s interleaved
+static Bdd adder(Space* space, const Domain& a, const Domain& b, const Domain& s)
+{
+	Bdd res(space, true);
+	Bdd carry(space, false);
+
+	Domain::const_iterator a_i = a.begin();
+	Domain::const_iterator b_i = b.begin();
+	Domain::const_iterator s_i = s.begin();
+
+	while (a_i != a.end())
+	{
+		Bdd bit_a = Bdd::var_true(space, *a_i);
+		Bdd bit_b = Bdd::var_true(space, *b_i);
+		Bdd bit_s = Bdd::var_true(space, *s_i);
+
+		res &= bdd_iff(bit_s, bdd_xor(bdd_xor(bit_a, bit_b), carry));
+		carry = (bit_a & bit_b) | (bit_a & carry) | (bit_b & carry);
+
+		++a_i;
+		++b_i;
+		++s_i;
+	}
+
+	return res;
+}
+
+/// Symbolic adder, returns whether 3 + 4 = 7 is in the relation
+static unsigned long int bench_adder(Run& run, unsigned int n_bits)
+{
+	Space* space = run.get_space();
+	Bdd::Vars x(space);
+	Bdd::FiniteVars v = x[Domain(0, n_bits, 3) * Domain(1, n_bits, 3) * Domain(2, n_bits, 3)];
+
+	Bdd sum = adder(space, v[0].get_domain(), v[1].get_domain(), v[2].get_domain());
+	run.sample();
+
+	return (sum & (v[0] == 3) & (v[1] == 4) & (v[2] == 7)).is_false() ? 0 : 1;
+}
+
+/// Successor relation modulo 2^n_bits
+static BddRelation successor(Space* space, unsigned int n_bits)
+{
+	Bdd::Vars x(space);
+	Bdd::FiniteVars v = x[Domain(0, n_bits, 2) * Domain(1, n_bits, 2)];
+
+	Domain from = v[0].get_domain();
+	Domain to = v[1].get_domain();
+
+	Bdd res(space, true);
+	Bdd carry(space, true);
+
+	Domain::const_iterator from_i = from.begin();
+	Domain::const_iterator to_i = to.begin();
+
+	while (from_i != from.end())
+	{
+		Bdd bit_from = Bdd::var_true(space, *from_i);
+		Bdd bit_to = Bdd::var_true(space, *to_i);
+
+		res &= bdd_iff(bit_to, bdd_xor(bit_from, carry));
+		carry = bit_from & carry;
+
+		++from_i;
+		++to_i;
+	}
+
+	return BddRelation(v, res);
+}
+
+/// Compose the successor relation with itself, returns number of compositions
+static unsigned long int bench_compose(Run& run, unsigned int n_bits)
+{
+	BddRelation succ = successor(run.get_space(), n_bits);
+	BddRelation rel = succ;
+	unsigned long int n = 0;
+
+	for (unsigned int i = 0;i < 4 * n_bits;++i)
+	{
+		rel = rel.compose(1, succ);
+		run.sample();
+		n++;
+	}
+
+	return n;
+}
+
+/// Insert pseudo random values into a set and iterate over it, returns size of set
+static unsigned long int bench_set(Run& run, unsigned int n_values)
+{
+	BddSet s(run.get_space());
+	unsigned int v = 1;
+
+	for (unsigned int i = 0;i < n_values;++i)
+	{
+		v = (v * 1103515245 + 12345) & 0x7fffffff;
+		s.insert(v >> 12);
+
+		if ((i & 0xff) == 0) run.sample();
+	}
+
+	run.sample();
+
+	unsigned long int n = 0;
+
+	for (BddSet::const_iterator i = s.begin();i != s.end();++i)
+	{
+		n++;
+	}
+
+	return n;
+}
+
+/// Quotient under congruence modulo 2^(n_bits / 2), returns number of classes
+static unsigned long int bench_quotient(Run& run, unsigned int n_bits)
+{
+	Space* space = run.get_space();
+	Bdd::Vars x(space);
+	Bdd::FiniteVars v = x[Domain(0, n_bits, 2) * Domain(1, n_bits, 2)];
+
+	unsigned int n_low = n_bits / 2;
+
+	BddEquivalenceRelation congruence(v[0].get_domain(), v[1].get_domain(),
+					  Bdd::vars_equal(space,
+							  v[0].get_domain().first_n(n_low),
+							  v[1].get_domain().first_n(n_low)));
+	run.sample();
+
+	vector<BddSet> classes = congruence.quotient(BddSet(v[0].get_domain(), Bdd(space, true)));
+	run.sample();
+
+	return classes.size();
+}
+
+/// Reachable states from 0 under x' = x + 1 and x' = 2x + b, returns number of iterations
+static unsigned long int bench_reachability(Run& run, unsigned int n_bits)
+{
+	Space* space = run.get_space();
+	Bdd::Vars x(space);
+	Bdd::FiniteVars v = x[Domain(0, n_bits, 2) * Domain(1, n_bits, 2)];
+
+	// Bit i + 1 of x' is bit i of x, bit 0 of x' is unconstrained
+
+	Domain from = v[0].get_domain();
+	Domain to = v[1].get_domain();
+
+	Bdd shift(space, true);
+
+	Domain::const_iterator from_i = from.begin();
+	Domain::const_iterator to_i = to.begin();
+
+	for (++to_i;to_i != to.end();++from_i, ++to_i)
+	{
+		shift &= Bdd::var_equal(space, *from_i, *to_i);
+	}
+
+	BddBinaryRelation step(BddRelation(successor(space, n_bits)) | BddRelation(v, shift));
+	run.sample();
+
+	BddSet reached(v[0].get_domain(), v[0] == 0);
+	unsigned long int n_iterations = 0;
+
+	while (true)
+	{
+		BddSet next = reached | BddSet(v[0].get_domain(), step.image_under(reached));
+		run.sample();
+		n_iterations++;
+
+		if (next == reached) break;
+
+		reached = next;
+	}
+
+	return n_iterations;
+}
+
+/*
+ * Running benchmarks
+ */
+
+static struct
+{
+	const char* name;
+	unsigned long int (*bench_f)(Run& run, unsigned int size);
+	unsigned int size;
+}
+workloads[] =
+{
+	{"queens", bench_queens, 8},
+	{"adder", bench_adder, 64},
+	{"compose", bench_compose, 6},
+	{"set_insert_iterate", bench_set, 1000},
+	{"quotient", bench_quotient, 10},
+	{"reachability", bench_reachability, 12}
+};
+
+static const char* spaces[] =
+{
+	"gspace",
+#ifdef GBDD_WITH_BUDDY
+	"buddy",
+#endif
+#ifdef GBDD_WITH_CUDD
+	"cudd",
+#endif
+};
+
+/// Create space by name, returns NULL if the space is not compiled in
+static Space* create_space(const string& name)
+{
+	if (name == "gspace") return new GSpace();
+#ifdef GBDD_WITH_BUDDY
+	if (name == "buddy") return new BuddySpace();
+#endif
+#ifdef GBDD_WITH_CUDD
+	if (name == "cudd") return new CuddSpace();
+#endif
+
+	return NULL;
+}
+
+static void run_workload(const char* space_name, unsigned int workload_index)
+{
+	Space* space = create_space(space_name);
+
+	assert(space != NULL);
+
+	Run run(space);
+
+	struct timeval start;
+	gettimeofday(&start, NULL);
+
+	unsigned long int result = workloads[workload_index].bench_f(run, workloads[workload_index].size);
+
+	struct timeval stop;
+	gettimeofday(&stop, NULL);
+
+	run.sample();
+
+	struct rusage usage;
+	getrusage(RUSAGE_SELF, &usage);
+
+	double seconds = (stop.tv_sec - start.tv_sec) + (stop.tv_usec - start.tv_usec) / 1000000.0;
+
+	cout << "{\"space\":\"" << space_name << "\","
+	     << "\"workload\":\"" << workloads[workload_index].name << "\","
+	     << "\"size\":" << workloads[workload_index].size << ","
+	     << "\"seconds\":" << seconds << ","
+	     << "\"peak_nodes\":" << run.get_peak_nodes() << ","
+	     << "\"max_rss_kb\":" << usage.ru_maxrss << ","
+	     << "\"result\":" << result << "}" << endl;
+
+	delete space;
+}
+
+static void usage(const char* name)
+{
+	cerr << "usage: " << name << " [-s space] [-w workload] [-n size]" << endl;
+	cerr << "  -s  only run on space (gspace, buddy or cudd)" << endl;
+	cerr << "  -w  only run workload" << endl;
+	cerr << "  -n  size of the workload given with -w instead of its default size" << endl;
+}
+
+int main(int argc, char** argv)
+{
+	const char* only_space = NULL;
+	const char* only_workload = NULL;
+	unsigned int size = 0;
+
+	for (int i = 1;i < argc;++i)
+	{
+		if (strcmp(argv[i], "-s") == 0 && i + 1 < argc)
+		{
+			only_space = argv[++i];
+		}
+		else if (strcmp(argv[i], "-w") == 0 && i + 1 < argc)
+		{
+			only_workload = argv[++i];
+		}
+		else if (strcmp(argv[i], "-n") == 0 && i + 1 < argc)
+		{
+			size = atoi(argv[++i]);
+		}
+		else
+		{
+			usage(argv[0]);
+			return 1;
+		}
+	}
+
+	if (only_space != NULL)
+	{
+		unsigned int i = 0;
+		while (i < sizeof(spaces) / sizeof(spaces[0]) && strcmp(only_space, spaces[i]) != 0) ++i;
+
+		if (i == sizeof(spaces) / sizeof(spaces[0]))
+		{
+			cerr << only_space << ": unknown space or not compiled in" << endl;
+			return 1;
+		}
+	}
+
+	if (only_workload != NULL)
+	{
+		unsigned int j = 0;
+		while (j < sizeof(workloads) / sizeof(workloads[0]) && strcmp(only_workload, workloads[j].name) != 0) ++j;
+
+		if (j == sizeof(workloads) / sizeof(workloads[0]))
+		{
+			cerr << only_workload << ": unknown workload" << endl;
+			return 1;
+		}
+
+		if (size != 0) workloads[j].size = size;
+	}
+	else if (size != 0)
+	{
+		// Sizes mean different things to different workloads
+
+		usage(argv[0]);
+		return 1;
+	}
+
+	int status = 0;
+
+	for (unsigned int i = 0;i < sizeof(spaces) / sizeof(spaces[0]);++i)
+	{
+		if (only_space != NULL && strcmp(only_space, spaces[i]) != 0) continue;
+
+		for (unsigned int j = 0;j < sizeof(workloads) / sizeof(workloads[0]);++j)
+		{
+			if (only_workload != NULL && strcmp(only_workload, workloads[j].name) != 0) continue;
+
+			cout.flush();
+
+			pid_t pid = fork();
+
+			if (pid == 0)
+			{
+				run_workload(spaces[i], j);
+				exit(0);
+			}
+
+			int child_status;
+			waitpid(pid, &child_status, 0);
+
+			if (!WIFEXITED(child_status) || WEXITSTATUS(child_status) != 0)
+			{
+				cerr << workloads[j].name << " failed on " << spaces[i] << endl;
+				status = 1;
+			}
+		}
+	}
+
+	return status;
+}
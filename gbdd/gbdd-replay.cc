@@ -0,0 +1,139 @@
+/*
+ * gbdd-replay.cc: Replay a trace written by TracingSpace
+ *
+ * Copyright (C) 2004 Marcus Nilsson (marcusn@it.uu.se)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Authors:
+ *    Marcus Nilsson (marcusn@it.uu.se)
+ */
+
+#include <gbdd/gbdd.h>
+#include <gbdd/cudd-space.h>
+#include <iostream>
+#include <fstream>
+#include <string.h>
+
+using namespace gbdd;
+
+static void usage(const char* name)
+{
+	cerr << "usage: " << name << " [-s gspace|buddy|cudd] [-p] [-n] trace" << endl;
+	cerr << "  -s  space to replay in (default gspace)" << endl;
+	cerr << "  -p  profile operations of the replay" << endl;
+	cerr << "  -n  sample peak nodes after every operation, included in the time" << endl;
+}
+
+static Space* create_space(const string& name)
+{
+	if (name == "gspace") return new GSpace();
+#ifdef GBDD_WITH_BUDDY
+	if (name == "buddy") return new BuddySpace();
+#endif
+#ifdef GBDD_WITH_CUDD
+	if (name == "cudd") return new CuddSpace();
+#endif
+
+	return NULL;
+}
+
+int main(int argc, char** argv)
+{
+	string space_name = "gspace";
+	bool profile = false;
+	bool sample_nodes = false;
+	const char* filename = NULL;
+
+	for (int i = 1;i < argc;++i)
+	{
+		if (strcmp(argv[i], "-s") == 0 && i + 1 < argc)
+		{
+			space_name = argv[++i];
+		}
+		else if (strcmp(argv[i], "-p") == 0)
+		{
+			profile = true;
+		}
+		else if (strcmp(argv[i], "-n") == 0)
+		{
+			sample_nodes = true;
+		}
+		else if (filename == NULL && argv[i][0] != '-')
+		{
+			filename = argv[i];
+		}
+		else
+		{
+			usage(argv[0]);
+			return 1;
+		}
+	}
+
+	if (filename == NULL)
+	{
+		usage(argv[0]);
+		return 1;
+	}
+
+	Space* base = create_space(space_name);
+
+	if (base == NULL)
+	{
+		cerr << "space " << space_name << " not available" << endl;
+		return 1;
+	}
+
+	ProfilingSpace* profiling = NULL;
+	Space* space = base;
+
+	if (profile)
+	{
+		profiling = new ProfilingSpace(auto_ptr<Space>(base), false);
+		space = profiling;
+	}
+
+	ifstream trace(filename, ios::in | ios::binary);
+
+	if (!trace)
+	{
+		cerr << "could not open " << filename << endl;
+		return 1;
+	}
+
+	try
+	{
+		TraceReplay replay(space, sample_nodes);
+		TraceReplay::Statistics stats = replay.replay(trace);
+
+		cout << "space: " << space_name << endl;
+		cout << "operations: " << stats.n_operations << endl;
+		cout << "time: " << stats.seconds << " s" << endl;
+		cout << "peak nodes: " << stats.peak_nodes << endl;
+
+		space->print_statistics(cout);
+
+		if (profiling != NULL) profiling->print(cout);
+	}
+	catch (Space::Error& e)
+	{
+		cerr << filename << ": " << e.description() << endl;
+		return 1;
+	}
+
+	delete space;
+
+	return 0;
+}
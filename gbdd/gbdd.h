@@ -28,11 +28,28 @@
 #include <gbdd/gspace.h>
 #include <gbdd/buddy-space.h>
 #include <gbdd/mutex-space.h>
+#include <gbdd/profiling-space.h>
+#include <gbdd/tracing-space.h>
 #include <gbdd/domain.h>
 #include <gbdd/bdd.h>
 #include <gbdd/structure-relation.h>
 #include <gbdd/bdd-relation.h>
 #include <gbdd/bdd-equivalence-relation.h>
+#include <gbdd/bdd-reachability.h>
+#include <gbdd/bdd-partitioned-relation.h>
+#include <gbdd/bdd-saturation.h>
+#include <gbdd/bdd-expression.h>
+#include <gbdd/bdd-serializer.h>
+#include <gbdd/bdd-snapshot.h>
+#include <gbdd/frozen-bdd.h>
+#include <gbdd/bdd-batch-evaluator.h>
 #include <gbdd/relation-compat.h>
+#include <gbdd/bitset-constraint.h>
+#include <gbdd/adaptive-set.h>
+#include <gbdd/node-table.h>
+#include <gbdd/zdd-space.h>
+#include <gbdd/zdd.h>
+#include <gbdd/add-space.h>
+#include <gbdd/add.h>
 
 #endif /* GBDD_H */
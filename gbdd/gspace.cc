@@ -383,6 +383,104 @@ GSpace::Bdd GSpace::bdd_rename_linear(Bdd p, _VarFunction fn)
 		      bdd_rename_linear(bdd_else(p), fn));
 }
 
+/**
+ * bdd_and_project:
+ * @param p BDD in conjunction 1
+ * @param q BDD in conjunction 2
+ * @param fn_var Predicate describing variables to project
+ *
+ * Projects variables given by \a fn_var in the conjunction of \a p and \a q,
+ * without building the conjunction
+ * 
+ * Returns: The projection of the conjunction
+ */
+
+GSpace::Bdd GSpace::bdd_and_project(Bdd p, Bdd q, VarPredicate& fn_var)
+{
+	HashBddPair<Bdd> cache;
+
+	return bdd_and_project(p, q, fn_var, cache);
+}
+
+GSpace::Bdd GSpace::bdd_and_project(Bdd p, Bdd q, VarPredicate& fn_var,
+				    HashBddPair<Bdd>& cache)
+{
+	if (bdd_is_leaf(p) && !bdd_leaf_value(p)) return p;
+	if (bdd_is_leaf(q) && !bdd_leaf_value(q)) return q;
+	if (bdd_is_leaf(p) && bdd_is_leaf(q)) return p;
+
+	{
+		HashBddPair<Bdd>::iterator i = cache.find(BddPair(p, q));
+		
+		if (i != cache.end())
+		{
+			return i->second;
+		}
+	}
+
+	Var v =
+		bdd_is_leaf(p) ? bdd_var(q):
+		bdd_is_leaf(q) ? bdd_var(p):
+		min(bdd_var(p), bdd_var(q));
+
+	Bdd p_then = (!bdd_is_leaf(p) && bdd_var(p) == v) ? bdd_then(p) : p;
+	Bdd p_else = (!bdd_is_leaf(p) && bdd_var(p) == v) ? bdd_else(p) : p;
+	Bdd q_then = (!bdd_is_leaf(q) && bdd_var(q) == v) ? bdd_then(q) : q;
+	Bdd q_else = (!bdd_is_leaf(q) && bdd_var(q) == v) ? bdd_else(q) : q;
+
+	Bdd r_then = bdd_and_project(p_then, q_then, fn_var, cache);
+	Bdd r;
+
+	if (fn_var(v))
+	{
+		// No need to look at the else-branches if the then-branches already give true
+
+		r = (bdd_is_leaf(r_then) && bdd_leaf_value(r_then)) ?
+			r_then:
+			Space::bdd_product(r_then, bdd_and_project(p_else, q_else, fn_var, cache), fn_or);
+	}
+	else
+	{
+		r = bdd_var_then_else(v, r_then, bdd_and_project(p_else, q_else, fn_var, cache));
+	}
+
+	cache[BddPair(p, q)] = r;
+
+	return r;
+}
+
+/// Get number of nodes in space
+/**
+ * Nodes are never removed from this space, so this is also the peak number of nodes
+ *
+ * @return Number of nodes created, including the two leaves
+ */
+
+unsigned int GSpace::get_n_nodes(void) const
+{
+	return node_table.size();
+}
+
+/// Print statistics of space
+/**
+ * Prints the number of nodes and the number of entries in the product caches
+ *
+ * @param os Stream to print on
+ */
+
+void GSpace::print_statistics(ostream& os) const
+{
+	os << "nodes: " << get_n_nodes() << endl;
+
+	for (unsigned int op = 0;op < product_cache.size();++op)
+	{
+		if (product_cache[op].size() != 0)
+		{
+			os << "product cache " << op << ": " << product_cache[op].size() << " entries" << endl;
+		}
+	}
+}
+
 /// Prints BDD
 /**
  * Prints BDD \a p in human readable form to stream \a os
@@ -107,6 +107,8 @@ class GSpace : public Space
 
 	Bdd bdd_project(Bdd p, VarPredicate& fn_var, ProductFunction& fn_prod,
 			HashBdd<Bdd>& cache);
+	Bdd bdd_and_project(Bdd p, Bdd q, VarPredicate& fn_var,
+			    HashBddPair<Bdd>& cache);
 
 	template <class _VarFunction>
        	Bdd bdd_rename_linear(Bdd p, _VarFunction fn);
@@ -137,8 +139,12 @@ public:
 	Bdd bdd_rename(Bdd p, const VarMap& fn);
 	Bdd bdd_product(Bdd p, Bdd q, ProductFunction& fn);
 	Bdd bdd_product(Bdd p, UnaryProductFunction& fn);
+	Bdd bdd_and_project(Bdd p, Bdd q, VarPredicate& fn_var);
 
 	void bdd_print(ostream &os, Bdd p);
+
+	unsigned int get_n_nodes(void) const;
+	void print_statistics(ostream& os) const;
 		
 };
 
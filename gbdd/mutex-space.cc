@@ -116,10 +116,21 @@ gbdd::Space::Bdd MutexSpace::bdd_project(Bdd p, VarPredicate& fn_var, ProductFun
 gbdd::Space::Bdd MutexSpace::bdd_rename(Bdd p, const VarMap& fn)  { lock(); Bdd res = space->bdd_rename(p, fn) ; unlock(); return res; }
 gbdd::Space::Bdd MutexSpace::bdd_product(Bdd p, Bdd q, ProductFunction& fn)  { lock(); Bdd res = space->bdd_product(p, q, fn) ; unlock(); return res;}
 gbdd::Space::Bdd MutexSpace::bdd_product(Bdd p, UnaryProductFunction& fn)  { lock(); Bdd res = space->bdd_product(p, fn) ; unlock(); return res; }
+gbdd::Space::Bdd MutexSpace::bdd_and_project(Bdd p, Bdd q, VarPredicate& fn_var)
+{ lock(); Bdd res = space->bdd_and_project(p, q, fn_var); unlock(); return res; }
+gbdd::Space::Bdd MutexSpace::bdd_forall(Bdd p, VarPredicate& fn_var)  { lock(); Bdd res = space->bdd_forall(p, fn_var) ; unlock(); return res; }
+gbdd::Space::Bdd MutexSpace::bdd_unique(Bdd p, VarPredicate& fn_var)  { lock(); Bdd res = space->bdd_unique(p, fn_var) ; unlock(); return res; }
+bool MutexSpace::bdd_intersects(Bdd p, Bdd q)  { lock(); bool res = space->bdd_intersects(p, q) ; unlock(); return res; }
+bool MutexSpace::bdd_implies(Bdd p, Bdd q)  { lock(); bool res = space->bdd_implies(p, q) ; unlock(); return res; }
+gbdd::Space::Bdd MutexSpace::bdd_restrict(Bdd p, Bdd care)  { lock(); Bdd res = space->bdd_restrict(p, care) ; unlock(); return res; }
+gbdd::Space::Bdd MutexSpace::bdd_constrain(Bdd p, Bdd care)  { lock(); Bdd res = space->bdd_constrain(p, care) ; unlock(); return res; }
+gbdd::Space::Bdd MutexSpace::bdd_compose(Bdd p, Var v, Bdd g)  { lock(); Bdd res = space->bdd_compose(p, v, g) ; unlock(); return res; }
+gbdd::Space::Bdd MutexSpace::bdd_vector_compose(Bdd p, const VarBddMap& fn)  { lock(); Bdd res = space->bdd_vector_compose(p, fn) ; unlock(); return res; }
 	
 void MutexSpace::bdd_print(ostream &os, Bdd p)  { lock(); space->bdd_print(os, p) ; unlock(); }
 
 unsigned int MutexSpace::get_n_nodes(void) const { return space->get_n_nodes(); }
+void MutexSpace::print_statistics(ostream& os) const { space->print_statistics(os); }
 
 }
 
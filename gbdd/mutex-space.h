@@ -72,10 +72,20 @@ namespace gbdd
 		Bdd bdd_rename(Bdd p, const VarMap& fn);
 		Bdd bdd_product(Bdd p, Bdd q, ProductFunction& fn);
 		Bdd bdd_product(Bdd p, UnaryProductFunction& fn);
+		Bdd bdd_and_project(Bdd p, Bdd q, VarPredicate& fn_var);
+		Bdd bdd_forall(Bdd p, VarPredicate& fn_var);
+		Bdd bdd_unique(Bdd p, VarPredicate& fn_var);
+		bool bdd_intersects(Bdd p, Bdd q);
+		bool bdd_implies(Bdd p, Bdd q);
+		Bdd bdd_restrict(Bdd p, Bdd care);
+		Bdd bdd_constrain(Bdd p, Bdd care);
+		Bdd bdd_compose(Bdd p, Var v, Bdd g);
+		Bdd bdd_vector_compose(Bdd p, const VarBddMap& fn);
 	
 		void bdd_print(ostream &os, Bdd p);
 		
 		unsigned int get_n_nodes(void) const;
+		void print_statistics(ostream& os) const;
 	};
 }
 
@@ -0,0 +1,255 @@
+/*
+ * node-table.h: 
+ *
+ * Copyright (C) 2004 Marcus Nilsson (marcusn@it.uu.se)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ * 
+ * Authors:
+ *    Marcus Nilsson (marcusn@it.uu.se)
+ */
+
+
+
+#ifndef GBDD_NODE_TABLE_H
+#define GBDD_NODE_TABLE_H
+
+#include <gbdd/space.h>
+
+namespace gbdd
+{
+	/// Node storage of the decision diagram spaces that are not gbdd::Space
+	/**
+	 * Nodes are numbered in the order they are created and are never
+	 * freed. A leaf holds a value, an internal node a variable and two
+	 * branches and is unique for them. The reduction rules of a kind of
+	 * diagram are applied by its space before var_then_else is called.
+	 * The table also keeps the operation caches of the space, indexed by
+	 * the operations of the space.
+	 */
+	template <class Value>
+	class NodeTable
+	{
+	public:
+		typedef Space::Var Var;
+		typedef unsigned long int Node;
+
+		/// Pair of nodes, key of unique tables and operation caches
+		class NodePair
+		{
+		public:
+			Node p, q;
+			NodePair(Node p, Node q) : p(p), q(q) {}
+
+			bool operator==(const NodePair np2) const
+			{
+				return (p == np2.p && q == np2.q);
+			}
+		};
+
+		struct hash_node_pair
+		{
+			size_t operator()(NodePair np) const
+			{
+				return np.p * 31 + np.q;
+			}
+		};
+
+		typedef hash_map<NodePair, Node, hash_node_pair> NodePairCache;
+	private:
+		class Entry
+		{
+		public:
+			bool is_leaf;
+			Value value;
+			Var v;
+			Node p_then, p_else;
+
+			Entry(const Value& value):
+				is_leaf(true),
+				value(value),
+				v(0),
+				p_then(0),
+				p_else(0)
+			{}
+
+			Entry(Var v, Node p_then, Node p_else):
+				is_leaf(false),
+				value(),
+				v(v),
+				p_then(p_then),
+				p_else(p_else)
+			{}
+		};
+
+		vector<Entry> entries;
+		vector<NodePairCache> unique_tables;
+		vector<NodePairCache> op_caches;
+	public:
+/// Constructor
+/**
+ * @param n_operations Number of operation caches
+ */
+		NodeTable(unsigned int n_operations) : op_caches(n_operations) {}
+
+		bool is_leaf(Node p) const { return entries[p].is_leaf; }
+
+/// Value of leaf
+/**
+ * @param p Leaf
+ *
+ * @return The value of \a p
+ */
+		const Value& get_value(Node p) const
+		{
+			assert(is_leaf(p));
+			return entries[p].value;
+		}
+
+		Var get_var(Node p) const
+		{
+			assert(!is_leaf(p));
+			return entries[p].v;
+		}
+
+		Node get_then(Node p) const
+		{
+			assert(!is_leaf(p));
+			return entries[p].p_then;
+		}
+
+		Node get_else(Node p) const
+		{
+			assert(!is_leaf(p));
+			return entries[p].p_else;
+		}
+
+/// Create leaf
+/**
+ * Leaves are not shared, the space keeps one leaf per value.
+ *
+ * @param value Value of leaf
+ *
+ * @return The new leaf
+ */
+		Node leaf(const Value& value)
+		{
+			entries.push_back(Entry(value));
+
+			return entries.size() - 1;
+		}
+
+		Node var_then_else(Var v, Node p_then, Node p_else);
+
+/// Cache of operation
+/**
+ * @param op Operation of the space
+ *
+ * @return Results of \a op by its operands
+ */
+		NodePairCache& op_cache(unsigned int op) { return op_caches[op]; }
+
+		void clear_op_caches();
+
+		unsigned long int get_n_cached() const;
+		unsigned int get_n_nodes() const { return entries.size(); }
+		unsigned int get_n_nodes(Node p) const;
+	};
+
+/// Create internal node
+/**
+ * @param v Variable of node, lower than the variables of \a p_then and \a p_else
+ * @param p_then Then-branch
+ * @param p_else Else-branch
+ *
+ * @return The node with \a v, \a p_then and \a p_else, created if there is none
+ */
+	template <class Value>
+	typename NodeTable<Value>::Node NodeTable<Value>::var_then_else(Var v, Node p_then, Node p_else)
+	{
+		assert((is_leaf(p_then) || get_var(p_then) > v) &&
+		       (is_leaf(p_else) || get_var(p_else) > v));
+
+		while (unique_tables.size() < (v+1))
+		{
+			unique_tables.push_back(NodePairCache());
+		}
+
+		typename NodePairCache::iterator i = unique_tables[v].find(NodePair(p_then, p_else));
+
+		if (i != unique_tables[v].end()) return i->second;
+
+		Node new_node = entries.size();
+		entries.push_back(Entry(v, p_then, p_else));
+		unique_tables[v][NodePair(p_then, p_else)] = new_node;
+
+		return new_node;
+	}
+
+/// Empty the operation caches
+	template <class Value>
+	void NodeTable<Value>::clear_op_caches()
+	{
+		for (typename vector<NodePairCache>::iterator i = op_caches.begin();i != op_caches.end();++i)
+		{
+			i->clear();
+		}
+	}
+
+/// Number of cached results
+/**
+ * @return Number of results in all operation caches
+ */
+	template <class Value>
+	unsigned long int NodeTable<Value>::get_n_cached() const
+	{
+		unsigned long int n_cached = 0;
+
+		for (typename vector<NodePairCache>::const_iterator i = op_caches.begin();i != op_caches.end();++i)
+		{
+			n_cached += i->size();
+		}
+
+		return n_cached;
+	}
+
+/// Count nodes
+/**
+ * @param p Node
+ *
+ * @return Number of nodes reachable from \a p, including leaves
+ */
+	template <class Value>
+	unsigned int NodeTable<Value>::get_n_nodes(Node p) const
+	{
+		hash_set<Node> visited;
+		vector<Node> stack(1, p);
+
+		while (!stack.empty())
+		{
+			Node q = stack.back();
+			stack.pop_back();
+
+			if (!visited.insert(q).second || is_leaf(q)) continue;
+
+			stack.push_back(get_then(q));
+			stack.push_back(get_else(q));
+		}
+
+		return visited.size();
+	}
+}
+
+#endif /* GBDD_NODE_TABLE_H */
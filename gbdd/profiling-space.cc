@@ -0,0 +1,454 @@
+/*
+ * profiling-space.cc:
+ *
+ * Copyright (C) 2004 Marcus Nilsson (marcusn@it.uu.se)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Authors:
+ *    Marcus Nilsson (marcusn@it.uu.se)
+ */
+
+#include <gbdd/profiling-space.h>
+#include <time.h>
+#include <vector>
+
+namespace gbdd
+{
+
+static const char* operation_names[] =
+{
+	"gc",
+	"ref",
+	"unref",
+	"is_leaf",
+	"leaf_value",
+	"then",
+	"else",
+	"var",
+	"leaf",
+	"var_true",
+	"var_false",
+	"var_then_else",
+	"highest_var",
+	"project",
+	"rename",
+	"and_project",
+	"intersects",
+	"implies",
+	"restrict",
+	"constrain",
+	"compose",
+	"vector_compose",
+	"forall",
+	"unique",
+	"unary_product"
+};
+
+ProfilingSpace::Profile::Profile():
+	n_calls(0),
+	total_ns(0),
+	max_ns(0),
+	n_nodes_in(0),
+	n_nodes_out(0),
+	max_nodes_out(0)
+{
+	for (unsigned int i = 0;i < n_buckets;++i)
+	{
+		histogram[i] = 0;
+	}
+}
+
+/// Record one call
+/**
+ * @param ns Time of call in nanoseconds
+ */
+void ProfilingSpace::Profile::record(unsigned long long int ns)
+{
+	unsigned int bucket = 0;
+
+	while (bucket + 1 < n_buckets && (ns >> (bucket + 1)) != 0) ++bucket;
+
+	n_calls++;
+	total_ns += ns;
+	if (ns > max_ns) max_ns = ns;
+	histogram[bucket]++;
+}
+
+/// Constructor
+/**
+ * @param space Space to profile, the profiling space takes ownership of it
+ * @param count_nodes Whether to count nodes of arguments and results of expensive operations
+ */
+ProfilingSpace::ProfilingSpace(auto_ptr<Space> space, bool count_nodes):
+	space(space),
+	count_nodes(count_nodes)
+{}
+
+ProfilingSpace::~ProfilingSpace()
+{}
+
+unsigned long long int ProfilingSpace::now()
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ((unsigned long long int)ts.tv_sec) * 1000000000ULL + ts.tv_nsec;
+}
+
+/// Get operation of product function
+/**
+ * @param fn Product function
+ *
+ * @return The product operation, offset by the truth table of \a fn
+ */
+ProfilingSpace::Operation ProfilingSpace::product_operation(ProductFunction& fn)
+{
+	unsigned int index = 0;
+
+	if (fn(true, true)) index |= 0x08;
+	if (fn(true, false)) index |= 0x04;
+	if (fn(false, true)) index |= 0x02;
+	if (fn(false, false)) index |= 0x01;
+
+	return (Operation)(OP_PRODUCT + index);
+}
+
+unsigned long int ProfilingSpace::n_nodes(Bdd p)
+{
+	hash_set<Bdd> visited;
+	vector<Bdd> explore;
+
+	explore.push_back(p);
+	visited.insert(p);
+
+	while (!explore.empty())
+	{
+		Bdd q = explore.back();
+		explore.pop_back();
+
+		if (!space->bdd_is_leaf(q))
+		{
+			Bdd q_then = space->bdd_then(q);
+			Bdd q_else = space->bdd_else(q);
+
+			if (visited.insert(q_then).second) explore.push_back(q_then);
+			if (visited.insert(q_else).second) explore.push_back(q_else);
+		}
+	}
+
+	return visited.size();
+}
+
+unsigned long int ProfilingSpace::n_nodes(Bdd p, Bdd q)
+{
+	return n_nodes(p) + n_nodes(q);
+}
+
+void ProfilingSpace::record_nodes(Operation op, unsigned long int n_in, Bdd res)
+{
+	Profile& profile = profiles[op];
+	unsigned long int n_out = n_nodes(res);
+
+	profile.n_nodes_in += n_in;
+	profile.n_nodes_out += n_out;
+	if (n_out > profile.max_nodes_out) profile.max_nodes_out = n_out;
+}
+
+/// Get profile of operation
+/**
+ * @param op Operation
+ *
+ * @return The profile recorded for \a op
+ */
+const ProfilingSpace::Profile& ProfilingSpace::get_profile(Operation op) const
+{
+	assert(op < N_OPERATIONS);
+
+	return profiles[op];
+}
+
+/// Get name of operation
+/**
+ * Products are named by their truth table, listing the value for (true, true), (true, false),
+ * (false, true) and (false, false), for example "product_1000" for conjunction.
+ *
+ * @param op Operation
+ *
+ * @return Printable name of \a op
+ */
+string ProfilingSpace::operation_name(Operation op)
+{
+	if (op < OP_PRODUCT) return operation_names[op];
+
+	unsigned int index = op - OP_PRODUCT;
+	string name = "product_";
+
+	for (int bit = 3;bit >= 0;--bit)
+	{
+		name += (index & (1 << bit)) ? '1' : '0';
+	}
+
+	return name;
+}
+
+/// Clear all recorded profiles
+void ProfilingSpace::reset()
+{
+	for (unsigned int i = 0;i < N_OPERATIONS;++i)
+	{
+		profiles[i] = Profile();
+	}
+}
+
+/// Print profiles as text
+/**
+ * Prints one line per operation that has been called, followed by the non-empty buckets of its histogram
+ *
+ * @param os Stream to print on
+ */
+void ProfilingSpace::print(ostream& os) const
+{
+	for (unsigned int i = 0;i < N_OPERATIONS;++i)
+	{
+		const Profile& profile = profiles[i];
+
+		if (profile.n_calls == 0) continue;
+
+		os << operation_name((Operation)i) << ": "
+		   << profile.n_calls << " calls, "
+		   << profile.total_ns << " ns total, "
+		   << (profile.total_ns / profile.n_calls) << " ns mean, "
+		   << profile.max_ns << " ns max";
+
+		if (profile.n_nodes_in != 0 || profile.n_nodes_out != 0)
+		{
+			os << ", " << profile.n_nodes_in << " nodes in, "
+			   << profile.n_nodes_out << " nodes out, "
+			   << profile.max_nodes_out << " max nodes out";
+		}
+
+		os << endl;
+
+		for (unsigned int j = 0;j < n_buckets;++j)
+		{
+			if (profile.histogram[j] != 0)
+			{
+				os << "\t[2^" << j << ", 2^" << (j + 1) << ") ns: " << profile.histogram[j] << endl;
+			}
+		}
+	}
+}
+
+/// Print profiles as JSON
+/**
+ * Prints an object mapping names of called operations to their profile. Histograms
+ * are printed as arrays of length ProfilingSpace::n_buckets.
+ *
+ * @param os Stream to print on
+ */
+void ProfilingSpace::print_json(ostream& os) const
+{
+	bool first = true;
+
+	os << "{";
+
+	for (unsigned int i = 0;i < N_OPERATIONS;++i)
+	{
+		const Profile& profile = profiles[i];
+
+		if (profile.n_calls == 0) continue;
+
+		if (!first) os << ",";
+		first = false;
+
+		os << "\"" << operation_name((Operation)i) << "\":{"
+		   << "\"calls\":" << profile.n_calls << ","
+		   << "\"total_ns\":" << profile.total_ns << ","
+		   << "\"max_ns\":" << profile.max_ns << ","
+		   << "\"nodes_in\":" << profile.n_nodes_in << ","
+		   << "\"nodes_out\":" << profile.n_nodes_out << ","
+		   << "\"max_nodes_out\":" << profile.max_nodes_out << ","
+		   << "\"histogram\":[";
+
+		for (unsigned int j = 0;j < n_buckets;++j)
+		{
+			if (j != 0) os << ",";
+			os << profile.histogram[j];
+		}
+
+		os << "]}";
+	}
+
+	os << "}" << endl;
+}
+
+#define PROFILE(op, call) \
+	unsigned long long int start = now(); \
+	call; \
+	profiles[op].record(now() - start)
+
+void ProfilingSpace::gc() { PROFILE(OP_GC, space->gc()); }
+
+void ProfilingSpace::lock_gc() { space->lock_gc(); }
+void ProfilingSpace::unlock_gc() { space->unlock_gc(); }
+
+void ProfilingSpace::bdd_ref(Bdd p) { PROFILE(OP_REF, space->bdd_ref(p)); }
+void ProfilingSpace::bdd_unref(Bdd p) { PROFILE(OP_UNREF, space->bdd_unref(p)); }
+
+bool ProfilingSpace::bdd_is_leaf(Bdd p) { PROFILE(OP_IS_LEAF, bool res = space->bdd_is_leaf(p)); return res; }
+
+bool ProfilingSpace::bdd_leaf_value(Bdd p) { PROFILE(OP_LEAF_VALUE, bool res = space->bdd_leaf_value(p)); return res; }
+
+Space::Bdd ProfilingSpace::bdd_then(Bdd p) { PROFILE(OP_THEN, Bdd res = space->bdd_then(p)); return res; }
+Space::Bdd ProfilingSpace::bdd_else(Bdd p) { PROFILE(OP_ELSE, Bdd res = space->bdd_else(p)); return res; }
+Space::Var ProfilingSpace::bdd_var(Bdd p) { PROFILE(OP_VAR, Var res = space->bdd_var(p)); return res; }
+
+Space::Bdd ProfilingSpace::bdd_leaf(bool v) { PROFILE(OP_LEAF, Bdd res = space->bdd_leaf(v)); return res; }
+Space::Bdd ProfilingSpace::bdd_var_true(Var v) { PROFILE(OP_VAR_TRUE, Bdd res = space->bdd_var_true(v)); return res; }
+Space::Bdd ProfilingSpace::bdd_var_false(Var v) { PROFILE(OP_VAR_FALSE, Bdd res = space->bdd_var_false(v)); return res; }
+Space::Bdd ProfilingSpace::bdd_var_then_else(Var v, Bdd p_then, Bdd p_else)
+{ PROFILE(OP_VAR_THEN_ELSE, Bdd res = space->bdd_var_then_else(v, p_then, p_else)); return res; }
+
+Space::Var ProfilingSpace::bdd_highest_var(Bdd p) { PROFILE(OP_HIGHEST_VAR, Var res = space->bdd_highest_var(p)); return res; }
+
+Space::Bdd ProfilingSpace::bdd_project(Bdd p, VarPredicate& fn_var, ProductFunction& fn_prod)
+{
+	unsigned long int n_in = count_nodes ? n_nodes(p) : 0;
+
+	PROFILE(OP_PROJECT, Bdd res = space->bdd_project(p, fn_var, fn_prod));
+
+	if (count_nodes) record_nodes(OP_PROJECT, n_in, res);
+
+	return res;
+}
+
+Space::Bdd ProfilingSpace::bdd_forall(Bdd p, VarPredicate& fn_var)
+{
+	unsigned long int n_in = count_nodes ? n_nodes(p) : 0;
+
+	PROFILE(OP_FORALL, Bdd res = space->bdd_forall(p, fn_var));
+
+	if (count_nodes) record_nodes(OP_FORALL, n_in, res);
+
+	return res;
+}
+
+Space::Bdd ProfilingSpace::bdd_unique(Bdd p, VarPredicate& fn_var)
+{
+	unsigned long int n_in = count_nodes ? n_nodes(p) : 0;
+
+	PROFILE(OP_UNIQUE, Bdd res = space->bdd_unique(p, fn_var));
+
+	if (count_nodes) record_nodes(OP_UNIQUE, n_in, res);
+
+	return res;
+}
+
+Space::Bdd ProfilingSpace::bdd_rename(Bdd p, const VarMap& fn)
+{
+	unsigned long int n_in = count_nodes ? n_nodes(p) : 0;
+
+	PROFILE(OP_RENAME, Bdd res = space->bdd_rename(p, fn));
+
+	if (count_nodes) record_nodes(OP_RENAME, n_in, res);
+
+	return res;
+}
+
+Space::Bdd ProfilingSpace::bdd_product(Bdd p, Bdd q, ProductFunction& fn)
+{
+	Operation op = product_operation(fn);
+	unsigned long int n_in = count_nodes ? n_nodes(p, q) : 0;
+
+	PROFILE(op, Bdd res = space->bdd_product(p, q, fn));
+
+	if (count_nodes) record_nodes(op, n_in, res);
+
+	return res;
+}
+
+Space::Bdd ProfilingSpace::bdd_product(Bdd p, UnaryProductFunction& fn)
+{
+	PROFILE(OP_UNARY_PRODUCT, Bdd res = space->bdd_product(p, fn));
+
+	return res;
+}
+
+Space::Bdd ProfilingSpace::bdd_and_project(Bdd p, Bdd q, VarPredicate& fn_var)
+{
+	unsigned long int n_in = count_nodes ? n_nodes(p, q) : 0;
+
+	PROFILE(OP_AND_PROJECT, Bdd res = space->bdd_and_project(p, q, fn_var));
+
+	if (count_nodes) record_nodes(OP_AND_PROJECT, n_in, res);
+
+	return res;
+}
+
+bool ProfilingSpace::bdd_intersects(Bdd p, Bdd q) { PROFILE(OP_INTERSECTS, bool res = space->bdd_intersects(p, q)); return res; }
+bool ProfilingSpace::bdd_implies(Bdd p, Bdd q) { PROFILE(OP_IMPLIES, bool res = space->bdd_implies(p, q)); return res; }
+
+Space::Bdd ProfilingSpace::bdd_restrict(Bdd p, Bdd care)
+{
+	unsigned long int n_in = count_nodes ? n_nodes(p, care) : 0;
+
+	PROFILE(OP_RESTRICT, Bdd res = space->bdd_restrict(p, care));
+
+	if (count_nodes) record_nodes(OP_RESTRICT, n_in, res);
+
+	return res;
+}
+
+Space::Bdd ProfilingSpace::bdd_constrain(Bdd p, Bdd care)
+{
+	unsigned long int n_in = count_nodes ? n_nodes(p, care) : 0;
+
+	PROFILE(OP_CONSTRAIN, Bdd res = space->bdd_constrain(p, care));
+
+	if (count_nodes) record_nodes(OP_CONSTRAIN, n_in, res);
+
+	return res;
+}
+
+Space::Bdd ProfilingSpace::bdd_compose(Bdd p, Var v, Bdd g)
+{
+	unsigned long int n_in = count_nodes ? n_nodes(p, g) : 0;
+
+	PROFILE(OP_COMPOSE, Bdd res = space->bdd_compose(p, v, g));
+
+	if (count_nodes) record_nodes(OP_COMPOSE, n_in, res);
+
+	return res;
+}
+
+Space::Bdd ProfilingSpace::bdd_vector_compose(Bdd p, const VarBddMap& fn)
+{
+	unsigned long int n_in = count_nodes ? n_nodes(p) : 0;
+
+	PROFILE(OP_VECTOR_COMPOSE, Bdd res = space->bdd_vector_compose(p, fn));
+
+	if (count_nodes) record_nodes(OP_VECTOR_COMPOSE, n_in, res);
+
+	return res;
+}
+
+void ProfilingSpace::bdd_print(ostream &os, Bdd p) { space->bdd_print(os, p); }
+
+unsigned int ProfilingSpace::get_n_nodes(void) const { return space->get_n_nodes(); }
+void ProfilingSpace::print_statistics(ostream& os) const { space->print_statistics(os); }
+
+}
@@ -0,0 +1,172 @@
+/*
+ * profiling-space.h:
+ *
+ * Copyright (C) 2004 Marcus Nilsson (marcusn@it.uu.se)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Authors:
+ *    Marcus Nilsson (marcusn@it.uu.se)
+ */
+
+#ifndef GBDD_PROFILING_SPACE_H
+#define GBDD_PROFILING_SPACE_H
+
+#include <gbdd/space.h>
+#include <memory>
+#include <iostream>
+
+namespace gbdd
+{
+	/// A wrapper space that records call counts and latencies of every operation of another space
+	/**
+	 * Each operation is timed and its latency is entered into a histogram with
+	 * logarithmic buckets, bucket i holding calls that took [2^i, 2^(i+1)) nanoseconds.
+	 * Products are recorded per product function, where the operation code is the
+	 * truth table of the function. For the expensive operations (products, projections and
+	 * renamings) the number of nodes of the arguments and the result are also recorded,
+	 * unless this is turned off in the constructor since counting nodes requires a
+	 * traversal of the BDDs.
+	 *
+	 * \code
+	 * ProfilingSpace* space = new ProfilingSpace(auto_ptr<Space>(new GSpace()));
+	 *
+	 * ... use space ...
+	 *
+	 * space->print_json(cout);
+	 * \endcode
+	 */
+	class ProfilingSpace : public gbdd::Space
+	{
+	public:
+		/// Number of buckets in latency histograms
+		static const unsigned int n_buckets = 40;
+
+		/// Profiled operations
+		enum Operation
+		{
+			OP_GC,
+			OP_REF,
+			OP_UNREF,
+			OP_IS_LEAF,
+			OP_LEAF_VALUE,
+			OP_THEN,
+			OP_ELSE,
+			OP_VAR,
+			OP_LEAF,
+			OP_VAR_TRUE,
+			OP_VAR_FALSE,
+			OP_VAR_THEN_ELSE,
+			OP_HIGHEST_VAR,
+			OP_PROJECT,
+			OP_RENAME,
+			OP_AND_PROJECT,
+			OP_INTERSECTS,
+			OP_IMPLIES,
+			OP_RESTRICT,
+			OP_CONSTRAIN,
+			OP_COMPOSE,
+			OP_VECTOR_COMPOSE,
+			OP_FORALL,
+			OP_UNIQUE,
+			OP_UNARY_PRODUCT,
+			OP_PRODUCT,
+			N_OPERATIONS = OP_PRODUCT + 16
+		};
+
+		/// Profile of one operation
+		class Profile
+		{
+		public:
+			unsigned long int n_calls;
+			unsigned long long int total_ns;
+			unsigned long long int max_ns;
+			unsigned long int histogram[n_buckets];
+
+			unsigned long long int n_nodes_in;
+			unsigned long long int n_nodes_out;
+			unsigned long long int max_nodes_out;
+
+			Profile();
+
+			void record(unsigned long long int ns);
+		};
+	private:
+		auto_ptr<Space> space;
+		bool count_nodes;
+
+		Profile profiles[N_OPERATIONS];
+
+		static unsigned long long int now();
+		static Operation product_operation(ProductFunction& fn);
+
+		unsigned long int n_nodes(Bdd p);
+		unsigned long int n_nodes(Bdd p, Bdd q);
+		void record_nodes(Operation op, unsigned long int n_in, Bdd res);
+	public:
+		ProfilingSpace(auto_ptr<Space> space, bool count_nodes = true);
+		virtual ~ProfilingSpace();
+
+		const Profile& get_profile(Operation op) const;
+		static string operation_name(Operation op);
+
+		void reset();
+		void print(ostream& os) const;
+		void print_json(ostream& os) const;
+
+		void gc();
+
+		void lock_gc();
+		void unlock_gc();
+
+		void bdd_ref(Bdd p);
+		void bdd_unref(Bdd p);
+
+		bool bdd_is_leaf(Bdd p);
+
+		bool bdd_leaf_value(Bdd p);
+
+		Bdd bdd_then(Bdd p);
+		Bdd bdd_else(Bdd p);
+		Var bdd_var(Bdd p);
+
+		Bdd bdd_leaf(bool v);
+		Bdd bdd_var_true(Var v);
+		Bdd bdd_var_false(Var v);
+		Bdd bdd_var_then_else(Var v, Bdd p_then, Bdd p_else);
+
+		Var bdd_highest_var(Bdd p);
+		Bdd bdd_project(Bdd p, VarPredicate& fn_var, ProductFunction& fn_prod);
+		Bdd bdd_rename(Bdd p, const VarMap& fn);
+		Bdd bdd_product(Bdd p, Bdd q, ProductFunction& fn);
+		Bdd bdd_product(Bdd p, UnaryProductFunction& fn);
+		Bdd bdd_and_project(Bdd p, Bdd q, VarPredicate& fn_var);
+		Bdd bdd_forall(Bdd p, VarPredicate& fn_var);
+		Bdd bdd_unique(Bdd p, VarPredicate& fn_var);
+		bool bdd_intersects(Bdd p, Bdd q);
+		bool bdd_implies(Bdd p, Bdd q);
+		Bdd bdd_restrict(Bdd p, Bdd care);
+		Bdd bdd_constrain(Bdd p, Bdd care);
+		Bdd bdd_compose(Bdd p, Var v, Bdd g);
+		Bdd bdd_vector_compose(Bdd p, const VarBddMap& fn);
+
+		void bdd_print(ostream &os, Bdd p);
+
+		unsigned int get_n_nodes(void) const;
+		void print_statistics(ostream& os) const;
+	};
+}
+
+#endif /* GBDD_PROFILING_SPACE_H */
@@ -27,6 +27,7 @@
 #include <gbdd/buddy-space.h>
 #include <gbdd/cudd-space.h>
 #include <gbdd/gspace.h>
+#include <iostream>
 
 #ifdef GBDD_WITH_BUDDY
 #include "buddy.h"
@@ -109,6 +110,387 @@ Space::Var Space::bdd_highest_var(Bdd p)
 	return bdd_highest_var(p, cache);
 }
 
+static bool fn_and(bool v1, bool v2) { return v1 && v2; }
+static bool fn_or(bool v1, bool v2) { return v1 || v2; }
+
+/// Conjunction and projection
+/**
+ * @param p First BDD
+ * @param q Second BDD
+ * @param fn_var Predicate describing variables to project
+ * 
+ * @return The BDD representing \a p AND \a q, OR projected on variables v with \a fn_var (v)
+ */
+Space::Bdd Space::bdd_and_project(Bdd p, Bdd q, VarPredicate& fn_var)
+{
+	Bdd conj = bdd_product(p, q, fn_and);
+
+	bdd_ref(conj);
+
+	ClosureBinaryFunction<ProductFunction, bool (*)(bool, bool)> cl_fn_or(fn_or);
+
+	Bdd res = bdd_project(conj, fn_var, (ProductFunction&)cl_fn_or);
+
+	bdd_unref(conj);
+
+	return res;
+}
+
+static bool fn_xor(bool v1, bool v2) { return v1 != v2; }
+
+/// Universal quantification
+/**
+ * @param p BDD to quantify
+ * @param fn_var Predicate describing variables to quantify
+ * 
+ * @return The BDD representing \a p, AND projected on variables v with \a fn_var (v)
+ */
+Space::Bdd Space::bdd_forall(Bdd p, VarPredicate& fn_var)
+{
+	ClosureBinaryFunction<ProductFunction, bool (*)(bool, bool)> cl_fn_and(fn_and);
+
+	return bdd_project(p, fn_var, (ProductFunction&)cl_fn_and);
+}
+
+/// Unique quantification
+/**
+ * @param p BDD to quantify
+ * @param fn_var Predicate describing variables to quantify
+ * 
+ * @return The BDD representing \a p, XOR projected on variables v with \a fn_var (v)
+ */
+Space::Bdd Space::bdd_unique(Bdd p, VarPredicate& fn_var)
+{
+	ClosureBinaryFunction<ProductFunction, bool (*)(bool, bool)> cl_fn_xor(fn_xor);
+
+	return bdd_project(p, fn_var, (ProductFunction&)cl_fn_xor);
+}
+
+/// Pair of BDDs in traversals of two BDDs
+class SpaceBddPair
+{
+public:
+	Space::Bdd p, q;
+	SpaceBddPair(Space::Bdd p, Space::Bdd q) : p(p), q(q) {}
+
+	bool operator==(const SpaceBddPair& bp2) const
+	{
+		return (p == bp2.p && q == bp2.q);
+	}
+};
+
+struct hash_space_bdd_pair
+{
+	size_t operator()(const SpaceBddPair& bp) const
+	{
+		return bp.p * 31 + bp.q;
+	}
+};
+
+typedef hash_set<SpaceBddPair, hash_space_bdd_pair> SpaceBddPairSet;
+
+/// Search for assignment satisfying two BDDs
+/**
+ * Non-leaf BDDs are assumed to be reduced, so they have both satisfying
+ * and falsifying assignments.
+ *
+ * @param space Space of BDDs
+ * @param p First BDD
+ * @param q Second BDD
+ * @param complement_q Whether to search in the complement of \a q
+ * @param visited Pairs already searched without finding an assignment
+ * 
+ * @return Whether some assignment satisfies \a p and \a q, or its complement
+ */
+static bool find_common(Space* space, Space::Bdd p, Space::Bdd q, bool complement_q, SpaceBddPairSet& visited)
+{
+	bool p_leaf = space->bdd_is_leaf(p);
+	bool q_leaf = space->bdd_is_leaf(q);
+
+	if (p_leaf && !space->bdd_leaf_value(p)) return false;
+	if (q_leaf && space->bdd_leaf_value(q) == complement_q) return false;
+	if (p_leaf || q_leaf) return true;
+
+	if (!visited.insert(SpaceBddPair(p, q)).second) return false;
+
+	Space::Var v = min(space->bdd_var(p), space->bdd_var(q));
+
+	Space::Bdd p_then = (space->bdd_var(p) == v) ? space->bdd_then(p) : p;
+	Space::Bdd p_else = (space->bdd_var(p) == v) ? space->bdd_else(p) : p;
+	Space::Bdd q_then = (space->bdd_var(q) == v) ? space->bdd_then(q) : q;
+	Space::Bdd q_else = (space->bdd_var(q) == v) ? space->bdd_else(q) : q;
+
+	return
+		find_common(space, p_then, q_then, complement_q, visited) ||
+		find_common(space, p_else, q_else, complement_q, visited);
+}
+
+/// Test for common assignment
+/**
+ * @param p First BDD
+ * @param q Second BDD
+ * 
+ * @return Whether \a p AND \a q is satisfiable
+ */
+bool Space::bdd_intersects(Bdd p, Bdd q)
+{
+	SpaceBddPairSet visited;
+
+	return find_common(this, p, q, false, visited);
+}
+
+/// Test for implication
+/**
+ * @param p First BDD
+ * @param q Second BDD
+ * 
+ * @return Whether \a p implies \a q
+ */
+bool Space::bdd_implies(Bdd p, Bdd q)
+{
+	SpaceBddPairSet visited;
+
+	return !find_common(this, p, q, true, visited);
+}
+
+typedef hash_map<SpaceBddPair, Space::Bdd, hash_space_bdd_pair> SpaceBddPairCache;
+
+/// Restrict to care set
+/**
+ * @param space Space of BDDs
+ * @param p BDD to simplify
+ * @param care Care set, not false
+ * @param fn_or Disjunction
+ * @param cache Results computed so far
+ * 
+ * @return \a p restricted to \a care
+ */
+static Space::Bdd restrict(Space* space, Space::Bdd p, Space::Bdd care, Space::ProductFunction& fn_or,
+			   SpaceBddPairCache& cache)
+{
+	if (space->bdd_is_leaf(care) || space->bdd_is_leaf(p)) return p;
+	if (p == care) return space->bdd_leaf(true);
+
+	SpaceBddPairCache::const_iterator i = cache.find(SpaceBddPair(p, care));
+
+	if (i != cache.end()) return i->second;
+
+	Space::Var v = space->bdd_var(p);
+	Space::Var v_care = space->bdd_var(care);
+	Space::Bdd res;
+
+	if (v_care < v)
+	{
+		// p does not depend on the top variable of the care set
+
+		res = restrict(space, p, space->bdd_product(space->bdd_then(care), space->bdd_else(care), fn_or),
+			       fn_or, cache);
+	}
+	else if (v_care == v)
+	{
+		Space::Bdd care_then = space->bdd_then(care);
+		Space::Bdd care_else = space->bdd_else(care);
+
+		if (space->bdd_is_leaf(care_then) && !space->bdd_leaf_value(care_then))
+		{
+			res = restrict(space, space->bdd_else(p), care_else, fn_or, cache);
+		}
+		else if (space->bdd_is_leaf(care_else) && !space->bdd_leaf_value(care_else))
+		{
+			res = restrict(space, space->bdd_then(p), care_then, fn_or, cache);
+		}
+		else
+		{
+			res = space->bdd_var_then_else(v,
+						       restrict(space, space->bdd_then(p), care_then, fn_or, cache),
+						       restrict(space, space->bdd_else(p), care_else, fn_or, cache));
+		}
+	}
+	else
+	{
+		res = space->bdd_var_then_else(v,
+					       restrict(space, space->bdd_then(p), care, fn_or, cache),
+					       restrict(space, space->bdd_else(p), care, fn_or, cache));
+	}
+
+	cache[SpaceBddPair(p, care)] = res;
+
+	return res;
+}
+
+/// Generalized cofactor
+/**
+ * @param space Space of BDDs
+ * @param p BDD to constrain
+ * @param care Care set, not false
+ * @param cache Results computed so far
+ * 
+ * @return \a p constrained by \a care
+ */
+static Space::Bdd constrain(Space* space, Space::Bdd p, Space::Bdd care, SpaceBddPairCache& cache)
+{
+	if (space->bdd_is_leaf(care) || space->bdd_is_leaf(p)) return p;
+	if (p == care) return space->bdd_leaf(true);
+
+	SpaceBddPairCache::const_iterator i = cache.find(SpaceBddPair(p, care));
+
+	if (i != cache.end()) return i->second;
+
+	Space::Var v = min(space->bdd_var(p), space->bdd_var(care));
+
+	Space::Bdd p_then = (space->bdd_var(p) == v) ? space->bdd_then(p) : p;
+	Space::Bdd p_else = (space->bdd_var(p) == v) ? space->bdd_else(p) : p;
+	Space::Bdd care_then = (space->bdd_var(care) == v) ? space->bdd_then(care) : care;
+	Space::Bdd care_else = (space->bdd_var(care) == v) ? space->bdd_else(care) : care;
+
+	Space::Bdd res;
+
+	if (space->bdd_is_leaf(care_then) && !space->bdd_leaf_value(care_then))
+	{
+		res = constrain(space, p_else, care_else, cache);
+	}
+	else if (space->bdd_is_leaf(care_else) && !space->bdd_leaf_value(care_else))
+	{
+		res = constrain(space, p_then, care_then, cache);
+	}
+	else
+	{
+		res = space->bdd_var_then_else(v,
+					       constrain(space, p_then, care_then, cache),
+					       constrain(space, p_else, care_else, cache));
+	}
+
+	cache[SpaceBddPair(p, care)] = res;
+
+	return res;
+}
+
+/// Restrict to care set
+/**
+ * @param p BDD to simplify
+ * @param care Care set
+ * 
+ * @return A BDD that agrees with \a p on \a care, false if \a care is false
+ */
+Space::Bdd Space::bdd_restrict(Bdd p, Bdd care)
+{
+	if (bdd_is_leaf(care) && !bdd_leaf_value(care)) return care;
+
+	ClosureBinaryFunction<ProductFunction, bool (*)(bool, bool)> cl_fn_or(fn_or);
+	SpaceBddPairCache cache;
+
+	return restrict(this, p, care, (ProductFunction&)cl_fn_or, cache);
+}
+
+/// Generalized cofactor
+/**
+ * @param p BDD to constrain
+ * @param care Care set
+ * 
+ * @return The generalized cofactor of \a p with respect to \a care, false if \a care is false
+ */
+Space::Bdd Space::bdd_constrain(Bdd p, Bdd care)
+{
+	if (bdd_is_leaf(care) && !bdd_leaf_value(care)) return care;
+
+	SpaceBddPairCache cache;
+
+	return constrain(this, p, care, cache);
+}
+
+static bool fn_diff(bool v1, bool v2) { return v1 && !v2; }
+
+/// Simultaneous functional composition
+/**
+ * @param space Space of BDDs
+ * @param p BDD to substitute in
+ * @param fn Mapping from variables to the BDDs substituted for them
+ * @param highest_var Highest variable in the mapping
+ * @param cache Results computed so far
+ * 
+ * @return The BDD \a p with \a fn (v) substituted for every variable v in the mapping
+ */
+static Space::Bdd vector_compose(Space* space, Space::Bdd p, const Space::VarBddMap& fn, Space::Var highest_var,
+				 hash_map<Space::Bdd, Space::Bdd>& cache)
+{
+	// No substituted variable below the top variable
+
+	if (space->bdd_is_leaf(p) || space->bdd_var(p) > highest_var) return p;
+
+	hash_map<Space::Bdd, Space::Bdd>::const_iterator i = cache.find(p);
+
+	if (i != cache.end()) return i->second;
+
+	Space::Var v = space->bdd_var(p);
+	Space::Bdd p_then = vector_compose(space, space->bdd_then(p), fn, highest_var, cache);
+	Space::Bdd p_else = vector_compose(space, space->bdd_else(p), fn, highest_var, cache);
+
+	Space::VarBddMap::const_iterator g = fn.find(v);
+	Space::Bdd res;
+
+	if (p_then == p_else)
+	{
+		res = p_then;
+	}
+	else if (g == fn.end() &&
+		 (space->bdd_is_leaf(p_then) || space->bdd_var(p_then) > v) &&
+		 (space->bdd_is_leaf(p_else) || space->bdd_var(p_else) > v))
+	{
+		res = space->bdd_var_then_else(v, p_then, p_else);
+	}
+	else
+	{
+		Space::Bdd p_test = (g == fn.end()) ? space->bdd_var_true(v) : g->second;
+
+		res = space->bdd_product(space->bdd_product(p_test, p_then, fn_and),
+					 space->bdd_product(p_else, p_test, fn_diff),
+					 fn_or);
+	}
+
+	cache[p] = res;
+
+	return res;
+}
+
+/// Functional composition
+/**
+ * @param p BDD to substitute in
+ * @param v Variable to substitute
+ * @param g BDD to substitute for \a v
+ * 
+ * @return The BDD \a p with \a g substituted for \a v
+ */
+Space::Bdd Space::bdd_compose(Bdd p, Var v, Bdd g)
+{
+	VarBddMap fn;
+
+	fn[v] = g;
+
+	return bdd_vector_compose(p, fn);
+}
+
+/// Simultaneous functional composition
+/**
+ * @param p BDD to substitute in
+ * @param fn Mapping from variables to the BDDs substituted for them
+ * 
+ * @return The BDD \a p with \a fn (v) substituted for every variable v in the mapping
+ */
+Space::Bdd Space::bdd_vector_compose(Bdd p, const VarBddMap& fn)
+{
+	if (fn.empty()) return p;
+
+	Var highest_var = 0;
+	for (VarBddMap::const_iterator i = fn.begin();i != fn.end();++i)
+	{
+		if (i->first > highest_var) highest_var = i->first;
+	}
+
+	hash_map<Bdd, Bdd> cache;
+
+	return vector_compose(this, p, fn, highest_var, cache);
+}
+
 /// Get number of nodes in Space
 /**
  * @return The number of nodes currently used in space
@@ -118,6 +500,15 @@ unsigned int Space::get_n_nodes(void) const
 	return 0;
 }
 
+/// Print statistics of Space
+/**
+ * @param os Stream to print on
+ */
+void Space::print_statistics(ostream& os) const
+{
+	os << "nodes: " << get_n_nodes() << endl;
+}
+
 typedef Space::VarMap VarMap;
 
 /// Union of maps
@@ -145,6 +145,12 @@ public:
 	typedef UnaryFunction<bool, bool> UnaryProductFunction;
 	typedef UnaryFunction<Var, bool> VarPredicate;
 	typedef Domain::VarMap VarMap;
+
+/**
+ * Mapping from variables to BDDs substituted for them
+ * 
+ */
+	typedef hash_map<Var, Bdd> VarBddMap;
 public:
 	// Destructor
 	virtual ~Space() {}
@@ -301,6 +307,114 @@ public:
  */
 	virtual Bdd bdd_product(Bdd p, UnaryProductFunction& fn) = 0;
 
+/// Conjunction and projection
+/**
+ * Computes the projection of the conjunction of two BDDs in one pass, without
+ * building the conjunction. The default implementation computes the conjunction
+ * and projects it.
+ *
+ * @param p First BDD
+ * @param q Second BDD
+ * @param fn_var Predicate describing variables to project
+ * 
+ * @return The BDD representing \a p AND \a q, OR projected on variables v with \a fn_var (v)
+ */
+	virtual Bdd bdd_and_project(Bdd p, Bdd q, VarPredicate& fn_var);
+
+/// Universal quantification
+/**
+ * The default implementation projects with AND.
+ *
+ * @param p BDD to quantify
+ * @param fn_var Predicate describing variables to quantify
+ * 
+ * @return The BDD representing \a p, AND projected on variables v with \a fn_var (v)
+ */
+	virtual Bdd bdd_forall(Bdd p, VarPredicate& fn_var);
+
+/// Unique quantification
+/**
+ * The default implementation projects with XOR.
+ *
+ * @param p BDD to quantify
+ * @param fn_var Predicate describing variables to quantify
+ * 
+ * @return The BDD representing \a p, XOR projected on variables v with \a fn_var (v)
+ */
+	virtual Bdd bdd_unique(Bdd p, VarPredicate& fn_var);
+
+/// Test for common assignment
+/**
+ * Stops at the first assignment satisfying both BDDs, and does not create
+ * any nodes. The default implementation traverses the BDDs.
+ *
+ * @param p First BDD
+ * @param q Second BDD
+ * 
+ * @return Whether \a p AND \a q is satisfiable
+ */
+	virtual bool bdd_intersects(Bdd p, Bdd q);
+
+/// Test for implication
+/**
+ * Stops at the first assignment satisfying \a p but not \a q, and does not
+ * create any nodes. The default implementation traverses the BDDs.
+ *
+ * @param p First BDD
+ * @param q Second BDD
+ * 
+ * @return Whether \a p implies \a q
+ */
+	virtual bool bdd_implies(Bdd p, Bdd q);
+
+/// Restrict to care set
+/**
+ * Simplifies a BDD using a care set, by the restrict operator of Coudert and Madre.
+ * The default implementation traverses the BDDs.
+ *
+ * @param p BDD to simplify
+ * @param care Care set
+ * 
+ * @return A BDD that agrees with \a p on \a care, and is usually smaller than \a p
+ */
+	virtual Bdd bdd_restrict(Bdd p, Bdd care);
+
+/// Generalized cofactor
+/**
+ * The default implementation traverses the BDDs.
+ *
+ * @param p BDD to constrain
+ * @param care Care set
+ * 
+ * @return The generalized cofactor of \a p with respect to \a care, which agrees with \a p on \a care
+ */
+	virtual Bdd bdd_constrain(Bdd p, Bdd care);
+
+/// Functional composition
+/**
+ * The default implementation uses bdd_vector_compose.
+ *
+ * @param p BDD to substitute in
+ * @param v Variable to substitute
+ * @param g BDD to substitute for \a v
+ * 
+ * @return The BDD \a p with \a g substituted for \a v
+ */
+	virtual Bdd bdd_compose(Bdd p, Var v, Bdd g);
+
+/// Simultaneous functional composition
+/**
+ * All variables are substituted at once, so a BDD substituted for one
+ * variable may depend on other substituted variables. The default
+ * implementation traverses the BDD.
+ *
+ * @param p BDD to substitute in
+ * @param fn Mapping from variables to the BDDs substituted for them
+ * 
+ * @return The BDD \a p with \a fn (v) substituted for every variable v in the mapping
+ */
+	virtual Bdd bdd_vector_compose(Bdd p, const VarBddMap& fn);
+
 	template <class _VarPredicate, class _ProductFunction>
 	Bdd bdd_project(Bdd p, _VarPredicate fn_var, _ProductFunction fn_prod);
 
@@ -310,6 +424,15 @@ public:
 	template <class _UnaryProductFunction>
 	Bdd bdd_product(Bdd p, _UnaryProductFunction fn);
 
+	template <class _VarPredicate>
+	Bdd bdd_and_project(Bdd p, Bdd q, _VarPredicate fn_var);
+
+	template <class _VarPredicate>
+	Bdd bdd_forall(Bdd p, _VarPredicate fn_var);
+
+	template <class _VarPredicate>
+	Bdd bdd_unique(Bdd p, _VarPredicate fn_var);
+
 	virtual void bdd_print(ostream &os, Bdd p) = 0;
 
 /// Get number of nodes in space
@@ -319,6 +442,14 @@ public:
  * @return Number of nodes 
  */
 	virtual unsigned int get_n_nodes(void) const;
+
+/// Print statistics of space
+/**
+ * Prints implementation specific statistics, such as node and cache usage, in human readable form
+ *
+ * @param os Stream to print on
+ */
+	virtual void print_statistics(ostream& os) const;
 		
 };
 
@@ -374,6 +505,52 @@ Space::Bdd Space::bdd_product(Bdd p, _UnaryProductFunction fn)
 	return bdd_product(p, (UnaryProductFunction&)cl_fn);
 }
 
+/// Conjunction and projection
+/**
+ * @param p First BDD
+ * @param q Second BDD
+ * @param fn_var Predicate describing variables to project
+ * 
+ * @return The BDD representing \a p AND \a q, OR projected on variables v with \a fn_var (v)
+ */
+template <class _VarPredicate>
+Space::Bdd Space::bdd_and_project(Bdd p, Bdd q, _VarPredicate fn_var)
+{
+	ClosureUnaryFunction<VarPredicate, _VarPredicate> cl_fn_var(fn_var);
+
+	return bdd_and_project(p, q, (VarPredicate&)cl_fn_var);
+}
+
+/// Universal quantification
+/**
+ * @param p BDD to quantify
+ * @param fn_var Predicate describing variables to quantify
+ * 
+ * @return The BDD representing \a p, AND projected on variables v with \a fn_var (v)
+ */
+template <class _VarPredicate>
+Space::Bdd Space::bdd_forall(Bdd p, _VarPredicate fn_var)
+{
+	ClosureUnaryFunction<VarPredicate, _VarPredicate> cl_fn_var(fn_var);
+
+	return bdd_forall(p, (VarPredicate&)cl_fn_var);
+}
+
+/// Unique quantification
+/**
+ * @param p BDD to quantify
+ * @param fn_var Predicate describing variables to quantify
+ * 
+ * @return The BDD representing \a p, XOR projected on variables v with \a fn_var (v)
+ */
+template <class _VarPredicate>
+Space::Bdd Space::bdd_unique(Bdd p, _VarPredicate fn_var)
+{
+	ClosureUnaryFunction<VarPredicate, _VarPredicate> cl_fn_var(fn_var);
+
+	return bdd_unique(p, (VarPredicate&)cl_fn_var);
+}
+
 }
 
 #endif /* GBDD_SPACE_H */
@@ -74,6 +74,26 @@ namespace gbdd
 				return StructureBinaryView(get_domain(1), get_domain(0), get_bdd_based());
 			}
 		
+/// Transitive closure
+/**
+ * @return The smallest transitive relation containing this relation
+ */
+		StructureBinaryView closure() const
+			{
+				return StructureBinaryView(StructureRelation::transitive_closure());
+			}
+
+/// Reflexive and transitive closure
+/**
+ * Both domains must be finite.
+ *
+ * @return The smallest reflexive and transitive relation containing this relation
+ */
+		StructureBinaryView reflexive_closure() const
+			{
+				return StructureBinaryView(StructureRelation::reflexive_transitive_closure());
+			}
+
 		static StructureBinaryView cross_product(const Domain& domain1,
 							const Domain& domain2,
 							const SetT& set1,
@@ -22,10 +22,27 @@
  */
 
 #include <gbdd/structure-constraint.h>
+#include <memory>
 
 namespace gbdd
 {
 	
+/// Conjunction and projection
+/**
+ * Implementations may override this to compute the result without building the conjunction
+ *
+ * @param b2 structure constraint object to take conjunction with
+ * @param vs Domain to project
+ * 
+ * @return The conjunction of this object and \a b2 with the variables in \a vs projected away
+ */
+StructureConstraint* StructureConstraint::ptr_and_project(const StructureConstraint& b2, Domain vs) const
+{
+	auto_ptr<StructureConstraint> conj(ptr_product(b2, fn_and));
+
+	return conj->ptr_project(vs);
+}
+
 StructureConstraint::Factory::~Factory()
 {}
 
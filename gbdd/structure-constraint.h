@@ -149,6 +149,8 @@ namespace gbdd
  */
 		virtual StructureConstraint* ptr_product(const StructureConstraint& b2, bool (*fn)(bool v1, bool v2)) const = 0;
 
+		virtual StructureConstraint* ptr_and_project(const StructureConstraint& b2, Domain vs) const;
+
 /// Negation
 /**
  * @return Negation of this object
@@ -22,6 +22,7 @@
  */
 
 #include <gbdd/structure-relation.h>
+#include <gbdd/bool-constraint.h>
 
 namespace gbdd
 {
@@ -389,8 +390,7 @@ static StructureRelation escape_from_domain(const StructureRelation& r, const Do
 
 	// For domains that overlap with d, allocate from unused, i.e. not from d or new_doms
 	StructureConstraint::VarPool pool;
-	pool.alloc(d);
-	pool.alloc(new_doms.union_all());
+	pool.alloc(d | new_doms.union_all());
 
 	for (unsigned int i = 0;i < new_doms.size();++i)
 	{
@@ -430,12 +430,110 @@ StructureRelation StructureRelation::compose(unsigned int compose_domain_index,
 	Domains doms_result = escaped_rel.get_domains();
 	doms_result[compose_domain_index] = dom_im;
 
-	auto_ptr<StructureConstraint> combined (escaped_rel.get_bdd_based().ptr_product(escaped_compose_rel.get_bdd_based(), StructureConstraint::fn_and));
-	auto_ptr<StructureConstraint> projected (combined->ptr_project(dom_range));
+	auto_ptr<StructureConstraint> projected (escaped_rel.get_bdd_based().ptr_and_project(escaped_compose_rel.get_bdd_based(), dom_range));
 
 	return StructureRelation(doms_result, *projected);
 }
 
+/// Transitive closure of binary relation
+/**
+ * The closure is computed by iterative squaring, i.e. R := R | R o R until
+ * a fixpoint is reached, so the number of iterations is logarithmic in the
+ * length of the longest chain. The squaring is a fused relational product
+ * over a third domain. The relation is renamed once to fresh domains where
+ * the from, via and to variables of each bit are adjacent, and back once
+ * at the end.
+ *
+ * @return The smallest transitive relation containing this relation
+ */
+StructureRelation StructureRelation::transitive_closure() const
+{
+	assert(arity() == 2);
+	assert(get_domain(0).is_compatible(get_domain(1)));
+	assert(get_domain(0).is_disjoint(get_domain(1)));
+
+	const Domains& ds = get_domains();
+
+	if (ds.is_some_infinite())
+	{
+		// Close in finite domains covering the variables of the relation
+
+		Domain::Var high = get_bdd_based().highest_var();
+		unsigned int n = 0;
+
+		for (unsigned int i = 0;i < ds.size();++i)
+		{
+			unsigned int n_used = (ds[i] & Domain(0, high + 1)).size();
+
+			if (n_used > n) n = n_used;
+		}
+
+		Domains finite_ds = ds;
+		for (unsigned int i = 0;i < finite_ds.size();++i)
+		{
+			finite_ds[i] = ds[i].first_n(n);
+		}
+
+		return StructureRelation(ds, StructureRelation(finite_ds, *this).transitive_closure());
+	}
+
+	const Domain& dom_from = ds[0];
+	const Domain& dom_to = ds[1];
+
+	// Square in an interleaved from/via/to layout, so that the
+	// intermediate relations stay small for relations on bits
+
+	StructureConstraint::VarPool pool;
+	pool.alloc(dom_from | dom_to);
+
+	Domains layout = pool.alloc_interleaved(dom_from.size(), 3);
+	const Domain& dom_from_i = layout[0];
+	const Domain& dom_via = layout[1];
+	const Domain& dom_to_i = layout[2];
+
+	Domain::VarMap to_to_via = Domain::map_vars(dom_to_i, dom_via);
+	Domain::VarMap from_to_via = Domain::map_vars(dom_from_i, dom_via);
+
+	auto_ptr<StructureConstraint> closure(get_bdd_based().ptr_rename(Domain::map_vars(dom_from, dom_from_i) |
+									 Domain::map_vars(dom_to, dom_to_i)));
+
+	while (true)
+	{
+		auto_ptr<StructureConstraint> left(closure->ptr_rename(to_to_via));
+		auto_ptr<StructureConstraint> right(closure->ptr_rename(from_to_via));
+		auto_ptr<StructureConstraint> squared(left->ptr_and_project(*right, dom_via));
+		auto_ptr<StructureConstraint> next(closure->ptr_product(*squared, StructureConstraint::fn_or));
+
+		if (*next == *closure) break;
+
+		closure = next;
+	}
+
+	auto_ptr<StructureConstraint> renamed_back(closure->ptr_rename(Domain::map_vars(dom_from_i, dom_from) |
+									Domain::map_vars(dom_to_i, dom_to)));
+
+	return StructureRelation(ds, *renamed_back);
+}
+
+/// Reflexive and transitive closure of binary relation
+/**
+ * Both domains must be finite, and the relation must be based on
+ * gbdd::BoolConstraint objects.
+ *
+ * @return The smallest reflexive and transitive relation containing this relation
+ */
+StructureRelation StructureRelation::reflexive_transitive_closure() const
+{
+	assert(arity() == 2);
+	assert(!get_domains().is_some_infinite());
+
+	const BoolConstraint& bb = dynamic_cast<const BoolConstraint&>(get_bdd_based());
+	auto_ptr<BoolConstraint::Factory> factory(bb.ptr_factory());
+	auto_ptr<BoolConstraint> identity(factory->ptr_vars_equal(get_domain(0), get_domain(1)));
+
+	return transitive_closure() | StructureRelation(get_domains(), *identity);
+}
+
 /// Obtain new relation using cross product of sets
 /**
  * The domain of set in \a contents must have the same number of
@@ -726,6 +824,193 @@ StructureRelation StructureRelation::restrict(unsigned int domain_index, const S
 
 	return StructureRelation(get_domains(), *res);
 }
+/// Selects elements with two equal components
+/**
+ * The domains must be finite, and the relation must be based on
+ * gbdd::BoolConstraint objects.
+ *
+ * @param domain_index1 Index of first component
+ * @param domain_index2 Index of second component
+ * 
+ * @return The elements of this relation where the components \a domain_index1 and \a domain_index2 are equal
+ */
+StructureRelation StructureRelation::select_equal(unsigned int domain_index1, unsigned int domain_index2) const
+{
+	assert(get_domain(domain_index1).is_finite() && get_domain(domain_index2).is_finite());
+	assert(get_domain(domain_index1).is_compatible(get_domain(domain_index2)));
+
+	const BoolConstraint& bb = dynamic_cast<const BoolConstraint&>(get_bdd_based());
+	auto_ptr<BoolConstraint::Factory> factory(bb.ptr_factory());
+	auto_ptr<BoolConstraint> equal(factory->ptr_vars_equal(get_domain(domain_index1), get_domain(domain_index2)));
+
+	auto_ptr<StructureConstraint> res(get_bdd_based().ptr_product(*equal, StructureConstraint::fn_and));
+
+	return StructureRelation(get_domains(), *res);
+}
+
+/// Reorders components
+/**
+ * Only the domains are reordered, the structure object is shared.
+ *
+ * @param domain_indices Index in this relation of each component of the result, a permutation of 0..arity()-1
+ * 
+ * @return The relation with component i being component \a domain_indices [i] of this relation
+ */
+StructureRelation StructureRelation::permute(const vector<unsigned int>& domain_indices) const
+{
+	assert(domain_indices.size() == arity());
+
+	Domains new_domains(arity());
+
+	for (unsigned int i = 0;i < arity();++i)
+	{
+		assert(domain_indices[i] < arity());
+
+		new_domains[i] = get_domain(domain_indices[i]);
+	}
+
+	return StructureRelation(new_domains, get_bdd_based());
+}
+
+/// Projects on several components
+/**
+ * @param domain_indices Indices of components to keep, in the order of the result
+ * 
+ * @return The relation of the components \a domain_indices of this relation
+ */
+StructureRelation StructureRelation::project_columns(const vector<unsigned int>& domain_indices) const
+{
+	vector<bool> keep(arity(), false);
+	Domains new_domains(domain_indices.size());
+
+	for (unsigned int i = 0;i < domain_indices.size();++i)
+	{
+		assert(domain_indices[i] < arity());
+		assert(!keep[domain_indices[i]]);
+
+		keep[domain_indices[i]] = true;
+		new_domains[i] = get_domain(domain_indices[i]);
+	}
+
+	Domain dom_project;
+
+	for (unsigned int i = 0;i < arity();++i)
+	{
+		if (keep[i]) continue;
+
+		if (get_domain(i).is_finite())
+		{
+			dom_project |= get_domain(i);
+		}
+		else
+		{
+			dom_project |= (get_domain(i) & Domain(0, get_bdd_based().highest_var() + 1));
+		}
+	}
+
+	auto_ptr<StructureConstraint> res(get_bdd_based().ptr_project(dom_project));
+
+	return StructureRelation(new_domains, *res);
+}
+
+/// Natural join of two relations
+/**
+ * The components \a domain_indices2 of \a r2 are placed on the domains
+ * of the components \a domain_indices1 of \a r1, and its other
+ * components on their own domains if these are free, so \a r2 is
+ * renamed at most once. The join is then one conjunction, fused with
+ * the projection of the join components if they are not kept. All
+ * domains must be finite.
+ *
+ * @param r1 First relation
+ * @param domain_indices1 Components of \a r1 to join on
+ * @param r2 Second relation
+ * @param domain_indices2 Components of \a r2 to join on, each one with the corresponding component in \a domain_indices1
+ * @param keep_join_domains Whether the components joined on are kept in the result
+ * 
+ * @return The relation of the components of \a r1, followed by the components of
+ *         \a r2 not joined on, such that the elements of both relations agree on the joined components.
+ *         The components of \a r1 in \a domain_indices1 are left out if \a keep_join_domains is false.
+ */
+StructureRelation StructureRelation::join(const StructureRelation& r1, const vector<unsigned int>& domain_indices1,
+					  const StructureRelation& r2, const vector<unsigned int>& domain_indices2,
+					  bool keep_join_domains)
+{
+	assert(domain_indices1.size() == domain_indices2.size());
+	assert(!r1.get_domains().is_some_infinite() && !r2.get_domains().is_some_infinite());
+
+	vector<bool> joined1(r1.arity(), false);
+	vector<bool> joined2(r2.arity(), false);
+
+	Domains placed(r2.arity());
+	Domain dom_joined;
+
+	for (unsigned int k = 0;k < domain_indices1.size();++k)
+	{
+		unsigned int i1 = domain_indices1[k];
+		unsigned int i2 = domain_indices2[k];
+
+		assert(i1 < r1.arity() && i2 < r2.arity());
+		assert(r1.get_domain(i1).is_compatible(r2.get_domain(i2)));
+
+		joined1[i1] = true;
+		joined2[i2] = true;
+		placed[i2] = r1.get_domain(i1);
+		dom_joined |= r1.get_domain(i1);
+	}
+
+	StructureConstraint::VarPool pool;
+	pool.alloc(r1.get_domains().union_all());
+
+	for (unsigned int i = 0;i < r2.arity();++i)
+	{
+		if (joined2[i]) continue;
+
+		placed[i] = r2.get_domain(i);
+
+		if (!pool.alloc(placed[i]))
+		{
+			placed[i] = pool.alloc(placed[i].size());
+		}
+	}
+
+	StructureRelation adapted(placed, r2);
+
+	// Result has the components of r1 followed by the other components of r2
+
+	vector<Domain> result_domains;
+
+	for (unsigned int i = 0;i < r1.arity();++i)
+	{
+		if (keep_join_domains || !joined1[i]) result_domains.push_back(r1.get_domain(i));
+	}
+
+	for (unsigned int i = 0;i < r2.arity();++i)
+	{
+		if (!joined2[i]) result_domains.push_back(placed[i]);
+	}
+
+	Domains ds(result_domains.size());
+
+	for (unsigned int i = 0;i < result_domains.size();++i)
+	{
+		ds[i] = result_domains[i];
+	}
+
+	auto_ptr<StructureConstraint> res;
+
+	if (keep_join_domains)
+	{
+		res.reset(r1.get_bdd_based().ptr_product(adapted.get_bdd_based(), StructureConstraint::fn_and));
+	}
+	else
+	{
+		res.reset(r1.get_bdd_based().ptr_and_project(adapted.get_bdd_based(), dom_joined));
+	}
+
+	return StructureRelation(ds, *res);
+}
+
 /// Copy Constructor
 /**
  * @param r  Relation to copy from
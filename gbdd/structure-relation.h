@@ -84,6 +84,9 @@ implemented with existing methods in this class.
 
 		StructureRelation compose(unsigned int domain_index, const StructureRelation& compose_rel) const;
 
+		StructureRelation transitive_closure() const;
+		StructureRelation reflexive_transitive_closure() const;
+
 		StructureRelation product(const StructureRelation& r2, bool (*fn)(bool v1, bool v2)) const;
 
 		bool operator==(const StructureRelation& rel2) const;
@@ -131,6 +134,16 @@ implemented with existing methods in this class.
 		StructureRelation project(unsigned int domain_index) const;
 
 		StructureRelation restrict(unsigned int domain_index, const StructureSet& to) const;
+
+		StructureRelation select_equal(unsigned int domain_index1, unsigned int domain_index2) const;
+
+		StructureRelation permute(const vector<unsigned int>& domain_indices) const;
+
+		StructureRelation project_columns(const vector<unsigned int>& domain_indices) const;
+
+		static StructureRelation join(const StructureRelation& r1, const vector<unsigned int>& domain_indices1,
+					      const StructureRelation& r2, const vector<unsigned int>& domain_indices2,
+					      bool keep_join_domains = true);
 	};
 
 	template <class StructureT, class RelationT, class SetT>
@@ -178,6 +191,16 @@ implemented with existing methods in this class.
 				return StructureRelation::compose(domain_index, compose_rel);
 			}
 
+		RelationT transitive_closure() const
+			{
+				return StructureRelation::transitive_closure();
+			}
+
+		RelationT reflexive_transitive_closure() const
+			{
+				return StructureRelation::reflexive_transitive_closure();
+			}
+
 		RelationT product(const RelationT& r2, bool (*fn)(bool v1, bool v2)) const
 			{
 				return StructureRelation::product(r2, fn);
@@ -245,6 +268,28 @@ implemented with existing methods in this class.
 			{
 				return StructureRelation::restrict(domain_index, to);
 			}
+
+		RelationT select_equal(unsigned int domain_index1, unsigned int domain_index2) const
+			{
+				return StructureRelation::select_equal(domain_index1, domain_index2);
+			}
+
+		RelationT permute(const vector<unsigned int>& domain_indices) const
+			{
+				return StructureRelation::permute(domain_indices);
+			}
+
+		RelationT project_columns(const vector<unsigned int>& domain_indices) const
+			{
+				return StructureRelation::project_columns(domain_indices);
+			}
+
+		static RelationT join(const RelationT& r1, const vector<unsigned int>& domain_indices1,
+				      const RelationT& r2, const vector<unsigned int>& domain_indices2,
+				      bool keep_join_domains = true)
+			{
+				return StructureRelation::join(r1, domain_indices1, r2, domain_indices2, keep_join_domains);
+			}
 	};
 
 	template <class StructureT, class RelationT, class SetT>
@@ -23,6 +23,10 @@
 
 #include <gbdd/gbdd.h>
 #include <iostream>
+#include <fstream>
+#include <iterator>
+#include <unistd.h>
+#include <string.h>
 
 using namespace gbdd;
 
@@ -85,6 +89,40 @@ static bool test_product()
 	return (p & q) == (z1 == 3);
 }
 
+class TruthTable
+{
+	unsigned int table;
+public:
+	TruthTable(unsigned int table) : table(table) {}
+
+	bool operator()(bool v1, bool v2) const
+	{
+		return (table & (1 << ((v1 ? 2 : 0) + (v2 ? 1 : 0)))) != 0;
+	}
+};
+
+static bool test_all_products()
+{
+	Bdd::Vars x(space);
+
+	Bdd p = (x[1] & x[2]) | ((!x[1]) & x[3]);
+	Bdd q = x[2] | x[4];
+
+	for (unsigned int table = 0;table < 16;++table)
+	{
+		Bdd expected(space, false);
+
+		if (table & 0x8) expected |= p & q;
+		if (table & 0x4) expected |= p - q;
+		if (table & 0x2) expected |= q - p;
+		if (table & 0x1) expected |= !(p | q);
+
+		if (!(Bdd::bdd_product(p, q, TruthTable(table)) == expected)) return false;
+	}
+
+	return true;
+}
+
 static bool test_varalloc()
 {
 	Bdd::VarPool pool;
@@ -129,6 +167,362 @@ static bool test_project()
 	return (p.project(Domain(3)) == q);
 }
 
+static bool test_and_project()
+{
+	Bdd::Vars x(space);
+
+	Bdd p = (x[1] & x[2]) | ((!x[1]) & x[3]);
+	Bdd q = x[1] | x[4];
+
+	return (Bdd::and_project(p, q, Domain(1)) == (p & q).project(Domain(1))) &&
+		(Bdd::and_project(p, q, Domain(1, 4)) == (p & q).project(Domain(1, 4))) &&
+		Bdd::and_project(p, !p, Domain(2)).is_false();
+}
+
+static bool test_intersects()
+{
+	Bdd::Vars x(space);
+	Bdd::FiniteVars v = x[Domain(0, 4) * Domain(4, 4)];
+
+	Bdd p = (x[1] & x[2]) | ((!x[1]) & x[3]);
+	Bdd q = x[1] | x[4];
+	Bdd lt = Bdd(space, false);
+	Bdd leq = Bdd(space, false);
+
+	for (unsigned int i = 0;i < 16;++i)
+	{
+		for (unsigned int j = i;j < 16;++j)
+		{
+			if (i != j) lt |= (v[0] == i) & (v[1] == j);
+			leq |= (v[0] == i) & (v[1] == j);
+		}
+	}
+
+	BddSet s(Domain(0, 4), (v[0] == 3) | (v[0] == 5));
+	BddSet s2(Domain(8, 4), Bdd::value(space, Domain(8, 4), 3));
+
+	return
+		p.intersects(q) == !(p & q).is_false() &&
+		!p.intersects(!p) &&
+		lt.leq(leq) && !leq.leq(lt) &&
+		lt.intersects(leq) && !lt.intersects((v[0] == 7) & (v[1] == 7)) &&
+		Bdd(space, false).leq(p) && p.leq(Bdd(space, true)) && !Bdd(space, true).leq(p) &&
+		s2.is_subset_of(s) && !s.is_subset_of(s2) && s.intersects(s2);
+}
+
+static bool test_restrict()
+{
+	Bdd::Vars x(space);
+	Bdd::FiniteVars v = x[Domain(0, 4) * Domain(4, 4)];
+
+	Bdd p = (x[1] & x[2]) | ((!x[1]) & x[3]) | ((!x[5]) & x[0]);
+	Bdd care = x[1] | x[6];
+	Bdd f = (v[0] == 3) | (v[0] == 9) | (v[0] == 12);
+	Bdd f_care = (v[0] == 3) | (v[0] == 7) | (v[0] == 9) | (v[0] == 11);
+
+	BddRelation r(Domains(Domain(0, 4)), f);
+	BddRelation r_care(Domains(Domain(0, 4)), f_care);
+	BddRelation r_min = r.minimize(r_care);
+
+	return
+		(p.restrict(care) & care) == (p & care) &&
+		(p.constrain(care) & care) == (p & care) &&
+		(f.restrict(f_care) & f_care) == (f & f_care) &&
+		(f.constrain(f_care) & f_care) == (f & f_care) &&
+		f.restrict(f_care).nodes().size() <= f.nodes().size() &&
+		p.restrict(x[1]) == (((!x[5]) & x[0]) | x[2]) &&
+		p.constrain(x[1]) == (((!x[5]) & x[0]) | x[2]) &&
+		p.restrict(p) == Bdd(space, true) &&
+		p.restrict(Bdd(space, true)) == p &&
+		p.restrict(Bdd(space, false)).is_false() &&
+		(r_min & r_care) == (r & r_care);
+}
+
+static bool test_compose()
+{
+	Bdd::Vars x(space);
+	Bdd::FiniteVars v = x[Domain(0, 4) * Domain(4, 4)];
+
+	Bdd p = (x[1] & x[2]) | ((!x[1]) & x[3]);
+	Bdd q = (!x[8]) | x[9];
+	Bdd low = (v[0] == 2) | (v[0] == 5);
+
+	Bdd::VarBddMap swap;
+	swap[1] = x[2];
+	swap[2] = x[1];
+
+	Bdd::VarBddMap update;
+	update[8] = (x[8] & x[9]) | x[0];
+	update[9] = x[8];
+
+	// Shift each bit of v[0] to v[1]
+
+	Bdd::VarBddMap shift;
+	for (unsigned int i = 0;i < 4;++i) shift[i] = x[4 + i];
+
+	return
+		p.compose(1, x[0]) == ((x[0] & x[2]) | ((!x[0]) & x[3])) &&
+		p.compose(2, Bdd(space, true)) == (x[1] | x[3]) &&
+		p.compose(1, x[9]) == ((x[9] & x[2]) | ((!x[9]) & x[3])) &&
+		p.compose(swap) == ((x[2] & x[1]) | ((!x[2]) & x[3])) &&
+		q.compose(update) == ((!((x[8] & x[9]) | x[0])) | x[8]) &&
+		low.compose(shift) == ((v[1] == 2) | (v[1] == 5)) &&
+		p.compose(Bdd::VarBddMap()) == p;
+}
+
+static bool test_quantification()
+{
+	Bdd::Vars x(space);
+
+	Bdd p = (x[1] & x[2]) | ((!x[1]) & x[3]);
+	Bdd q = ((!x[2]) & x[1]) | ((!x[1]) & x[2] & x[3]);
+
+	return
+		p.forall(Domain(1)) == (x[2] & x[3]) &&
+		p.forall(Domain(1)) == !((!p).exists(Domain(1))) &&
+		p.forall(Domain(2, 2)) == Bdd(space, false) &&
+		p.unique(Domain(1)) == (((!x[3]) & x[2]) | ((!x[2]) & x[3])) &&
+		q.unique(Domain(1, 2)) == !x[3] &&
+		p.forall(Domain()) == p &&
+		p.unique(Domain()) == p;
+}
+
+class CountCubes
+{
+	unsigned int n_vars;
+	unsigned int& n;
+public:
+	CountCubes(unsigned int n_vars, unsigned int& n) : n_vars(n_vars), n(n) {}
+
+	void operator()(const MappedBdd::Cube& cube) { n += 1 << (n_vars - cube.size()); }
+};
+
+static bool test_snapshot()
+{
+	Bdd::Vars x(space);
+	Bdd::FiniteVars v = x[Domain(0, 4, 2) * Domain(1, 4, 2)];
+	Domain vs = Domain(0, 4, 2) | Domain(1, 4, 2);
+
+	Bdd p = (v[0] == 3 & v[1] == 5) | v[0] == 9 | (v[0] == 12 & v[1] == 1);
+
+	vector<Bdd> bdds;
+	bdds.push_back(p);
+	bdds.push_back(Bdd(space, true));
+	bdds.push_back(p.project(Domain(1, 4, 2)));
+
+	BddSnapshot::write("test-snapshot.tmp", bdds);
+
+	bool res;
+	{
+		BddSnapshot snapshot("test-snapshot.tmp");
+
+		MappedBdd q = snapshot[0];
+		unsigned int n_cubes = 0;
+
+		q.for_each_cube(CountCubes(vs.size(), n_cubes));
+
+		res =
+			snapshot.size() == 3 &&
+			q.n_assignments(vs) == p.n_assignments(vs) &&
+			n_cubes == p.n_assignments(vs) &&
+			snapshot[1].is_leaf() && snapshot[1].leaf_value() &&
+			snapshot[2].n_assignments(Domain(0, 4, 2)) == 3;
+
+		for (unsigned int i = 0;i < 16;++i)
+		{
+			vector<unsigned int> values(2, 0);
+
+			values[0] = i;
+			values[1] = 5;
+
+			res = res &&
+				snapshot[2].value_member(Domain(0, 4, 2), i) == (i == 3 || i == 9 || i == 12) &&
+				q.member(v.get_domains(), values) == (i == 3 || i == 9);
+		}
+	}
+
+	// A node referring forward or a root outside the nodes is rejected
+
+	ifstream is("test-snapshot.tmp", ios::in | ios::binary);
+	string contents((istreambuf_iterator<char>(is)), istreambuf_iterator<char>());
+	is.close();
+
+	unlink("test-snapshot.tmp");
+
+	const uint32_t bad_index = 0xffffffff;
+	const size_t root_offset = 24;  // First root follows the header
+	const size_t last_then_offset = contents.size() - 2 * sizeof(uint32_t);
+
+	for (unsigned int i = 0;i < 2;++i)
+	{
+		string corrupt = contents;
+
+		memcpy(&corrupt[i == 0 ? root_offset : last_then_offset], &bad_index, sizeof(bad_index));
+
+		ofstream os("test-snapshot.tmp", ios::out | ios::binary | ios::trunc);
+		os << corrupt;
+		os.close();
+
+		try
+		{
+			BddSnapshot snapshot("test-snapshot.tmp");
+			res = false;
+		}
+		catch (const Space::Error& e)
+		{
+		}
+
+		unlink("test-snapshot.tmp");
+	}
+
+	return res;
+}
+
+static bool test_truth_table()
+{
+	Bdd::Vars x(space);
+	Domain vs(3, 10, 2);
+	Bdd::FiniteVar v = x[vs];
+
+	// Multiples of 3 below 600, and a function of the first 4 variables only
+
+	vector<uint64_t> bits(16, 0);
+	vector<uint64_t> low_bits(16, 0);
+	Bdd p(space, false);
+	Bdd q(space, false);
+
+	for (unsigned int i = 0;i < 1024;++i)
+	{
+		if (i % 3 == 0 && i < 600)
+		{
+			bits[i / 64] |= (uint64_t)1 << (i % 64);
+			p |= v == i;
+		}
+
+		if ((i & 0x0f) == 5 || (i & 0x0f) == 10)
+		{
+			low_bits[i / 64] |= (uint64_t)1 << (i % 64);
+			q |= v == i;
+		}
+	}
+
+	vector<uint64_t> exported(16, 1);
+	p.to_truth_table(vs, &exported[0]);
+
+	uint64_t small_bits = 0x96;
+	uint64_t small_exported = 0;
+	Bdd::from_truth_table(space, Domain(0, 3), &small_bits).to_truth_table(Domain(0, 3), &small_exported);
+
+	vector<uint64_t> zeros(16, 0);
+	vector<uint64_t> ones(16, ~(uint64_t)0);
+
+	return
+		Bdd::from_truth_table(space, vs, &bits[0]) == p &&
+		Bdd::from_truth_table(space, vs, &low_bits[0]) == q &&
+		exported == bits &&
+		small_exported == small_bits &&
+		Bdd::from_truth_table(space, vs, &zeros[0]).is_false() &&
+		Bdd::from_truth_table(space, vs, &ones[0]).is_true();
+}
+
+static bool test_profiling()
+{
+	ProfilingSpace profiling(auto_ptr<Space>(new GSpace()));
+	Bdd::Vars x(&profiling);
+
+	Bdd p = x[2] & x[3];
+	Bdd q = p.project(Domain(3));
+
+	const ProfilingSpace::Profile& and_profile =
+		profiling.get_profile((ProfilingSpace::Operation)(ProfilingSpace::OP_PRODUCT + 0x08));
+	const ProfilingSpace::Profile& project_profile =
+		profiling.get_profile(ProfilingSpace::OP_PROJECT);
+
+	return (q == x[2]) &&
+		and_profile.n_calls > 0 &&
+		project_profile.n_calls == 1 &&
+		project_profile.n_nodes_in == 4 &&
+		project_profile.n_nodes_out == 3 &&
+		ProfilingSpace::operation_name((ProfilingSpace::Operation)(ProfilingSpace::OP_PRODUCT + 0x08)) == "product_1000";
+}
+
+static bool test_tracing()
+{
+	const char* filename = "test-bdd.trace";
+	TracingSpace tracing(auto_ptr<Space>(new GSpace()), filename);
+
+	{
+		Bdd::Vars x(&tracing);
+
+		Bdd p = (x[2] & x[3]) | !x[5];
+		Bdd q = p.project(Domain(3));
+		Bdd r = q.rename(Domain::map_vars(Domain(2), Domain(7)));
+
+		// A child of a live node can still be used after a collection
+
+		Space::Bdd child = tracing.bdd_var_true(3);
+		Space::Bdd parent = tracing.bdd_var_then_else(2, child, tracing.bdd_leaf(false));
+
+		tracing.bdd_ref(parent);
+		tracing.gc();
+		(void)tracing.bdd_is_leaf(child);
+		tracing.bdd_unref(parent);
+	}
+
+	tracing.flush();
+
+	GSpace replayed;
+	TraceReplay replay(&replayed, true);
+
+	ifstream trace(filename, ios::in | ios::binary);
+	TraceReplay::Statistics stats = replay.replay(trace);
+
+	unlink(filename);
+
+	return stats.n_operations > 0 &&
+		stats.peak_nodes > 0 &&
+		replayed.get_n_nodes() == tracing.get_n_nodes();
+}
+
+static bool test_arithmetic()
+{
+	Bdd::Vars x(space);
+	Bdd::FiniteVars y = x[Domain(0,4,3) * Domain(1,4,3) * Domain(2,4,3)];
+
+	Bdd lt(space, false), le_5(space, false), gt_5(space, false), ge(space, false);
+	Bdd plus_3(space, false), minus_3(space, false), plus(space, false), minus(space, false), plus_9(space, false);
+
+	for (unsigned int a = 0;a < 16;++a)
+	{
+		if (a <= 5) le_5 |= y[0] == a;
+		if (a > 5) gt_5 |= y[0] == a;
+		if (a + 3 < 16) plus_3 |= (y[0] == a & y[1] == a + 3);
+		if (a >= 3) minus_3 |= (y[0] == a & y[1] == a - 3);
+
+		for (unsigned int b = 0;b < 16;++b)
+		{
+			if (a < b) lt |= (y[0] == a & y[1] == b);
+			if (a >= b) ge |= (y[0] == a & y[1] == b);
+			if (a + b < 16) plus |= (y[0] == a & y[1] == b & y[2] == a + b);
+			if (a >= b) minus |= (y[0] == a & y[1] == b & y[2] == a - b);
+			if (a + b == 9) plus_9 |= (y[0] == a & y[1] == b);
+		}
+	}
+
+	return
+		(y[0] < y[1]) == lt &&
+		(y[0] <= 5) == le_5 &&
+		(y[0] > 5) == gt_5 &&
+		(y[0] >= y[1]) == ge &&
+		(y[0] < 16) == Bdd(space, true) &&
+		(y[0] > 20) == Bdd(space, false) &&
+		(y[0] + 3 == y[1]) == plus_3 &&
+		(y[0] - 3 == y[1]) == minus_3 &&
+		(y[0] + y[1] == y[2]) == plus &&
+		(y[0] - y[1] == y[2]) == minus &&
+		(y[0] + y[1] == 9) == plus_9;
+}
+
 int main(int argc, char **argv)
 {
 	struct
@@ -143,7 +537,18 @@ int main(int argc, char **argv)
 		{"Variable allocation", test_varalloc},
 		{"Rename", test_rename},
 		{"Product", test_product},
-		{"Projection", test_project}
+		{"All products", test_all_products},
+		{"Projection", test_project},
+		{"And projection", test_and_project},
+		{"Intersection tests", test_intersects},
+		{"Restrict and constrain", test_restrict},
+		{"Composition", test_compose},
+		{"Quantification", test_quantification},
+		{"Snapshot", test_snapshot},
+		{"Truth tables", test_truth_table},
+		{"Profiling", test_profiling},
+		{"Tracing", test_tracing},
+		{"Arithmetic", test_arithmetic}
 	};
 
 	unsigned int i;
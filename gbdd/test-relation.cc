@@ -23,6 +23,8 @@
 
 #include <gbdd/gbdd.h>
 #include <iostream>
+#include <sstream>
+#include <limits>
 
 using namespace gbdd;
 
@@ -232,7 +234,728 @@ static bool test_infinite()
 		BddSet(BddRelation(domain1 * domain2, encode_1 & encode_2).project_on(0)).get_bdd() == encode_1;
 }
 
+static bool test_reachability()
+{
+	Bdd::Vars x(space);
+	Bdd::FiniteVars z = x[Domain(0, 3, 2) * Domain(1, 3, 2)];
+
+	// Successor modulo 8 without the step from 5 to 6
+
+	Bdd succ(space, false);
+	for (unsigned int i = 0;i < 8;++i)
+	{
+		if (i != 5) succ |= (z[0] == i) & (z[1] == ((i + 1) % 8));
+	}
+
+	BddReachability reachability(BddBinaryRelation(z[0].get_domain(), z[1].get_domain(), succ));
+
+	BddSet s(Domain(4, 3), Bdd(space, false));
+	BddSet s0 = BddSet(s, 0);
+	BddSet s5 = BddSet(s, 5);
+	BddSet s7 = BddSet(s, 7);
+
+	vector<BddSet> layers;
+	BddSet from_0 = reachability.forward(s0, layers);
+
+	vector<BddSet> hit_layers;
+	bool hits_5 = reachability.forward_hits(s0, s5, hit_layers);
+
+	vector<BddSet> miss_layers;
+	bool hits_7 = reachability.forward_hits(s0, s7, miss_layers);
+
+	return
+		(from_0 == BddSet(s, 0, 5)) &&
+		(layers.size() == 6) &&
+		(layers[3] == BddSet(s, 3)) &&
+		(reachability.image(s5).is_empty()) &&
+		(reachability.backward(s5) == BddSet(s, 0, 7)) &&
+		(reachability.preimage(s0) == s7) &&
+		hits_5 && hit_layers.size() == 6 && hit_layers.back() == s5 &&
+		!hits_7 && miss_layers.size() == 6;
+}
        
+static bool test_closure()
+{
+	Bdd::Vars x(space);
+	Bdd::FiniteVars z = x[Domain(0, 3, 2) * Domain(1, 3, 2)];
+
+	Domain d0 = z[0].get_domain();
+	Domain d1 = z[1].get_domain();
+
+	// Successor modulo 8 without the step from 5 to 6
+
+	Bdd succ(space, false);
+	for (unsigned int i = 0;i < 8;++i)
+	{
+		if (i != 5) succ |= (z[0] == i) & (z[1] == ((i + 1) % 8));
+	}
+
+	BddBinaryRelation r(d0, d1, succ);
+
+	BddBinaryRelation naive = r;
+	BddBinaryRelation prev;
+	do
+	{
+		prev = naive;
+		naive = naive | BddBinaryRelation(naive.compose(1, r));
+	} while (!(naive == prev));
+
+	BddBinaryRelation r_plus = r.closure();
+	BddBinaryRelation r_star = r.reflexive_closure();
+
+	BddBinaryRelation r_inf(Domain::infinite(0, 2), Domain::infinite(1, 2), r);
+
+	// Successor on 10 bits with the domains one after the other
+
+	Bdd::FiniteVars w = x[Domain(20, 10) * Domain(30, 10)];
+	BddBinaryRelation wide(w[0].get_domain(), w[1].get_domain(), w[0] + 1 == w[1]);
+
+	return
+		wide.closure() == BddBinaryRelation(w[0].get_domain(), w[1].get_domain(), w[0] < w[1]) &&
+		r_plus == naive &&
+		!((r_plus.get_bdd_based() & (z[0] == 6) & (z[1] == 5)) == Bdd(space, false)) &&
+		(r_plus.get_bdd_based() & (z[0] == 5) & (z[1] == 6)) == Bdd(space, false) &&
+		r_star == (r_plus | BddEquivalenceRelation::identity(space, d0, d1)) &&
+		!(r_star == r_plus) &&
+		BddBinaryRelation(d0, d1, r_inf.closure()) == naive;
+}
+
+static bool test_partitioned()
+{
+	Bdd::Vars x(space);
+	Bdd::FiniteVars z = x[Domain(0, 3, 2) * Domain(1, 3, 2)];
+
+	Domain d0 = z[0].get_domain();
+	Domain d1 = z[1].get_domain();
+
+	// Increment modulo 8, one part per bit of the next value
+
+	BddPartitionedRelation inc(space, BddPartitionedRelation::CONJUNCTIVE, d0, d1, 1);
+
+	inc.add(BddRelation(d0 * d1, Bdd::var_product(space, 0, 1, Bdd::fn_neq)));
+	inc.add(BddRelation(d0 * d1, Bdd::bdd_product(Bdd::var_product(space, 0, 2, Bdd::fn_neq), x[3], Bdd::fn_iff)));
+	inc.add(BddRelation(d0 * d1, Bdd::bdd_product(Bdd::var_product(space, 4, 5, Bdd::fn_neq), x[0] & x[2], Bdd::fn_iff)));
+
+	// Some steps of increment modulo 8, one part per step
+
+	BddPartitionedRelation steps(space, BddPartitionedRelation::DISJUNCTIVE, d0, d1, 1);
+
+	for (unsigned int i = 0;i < 8;i += 2)
+	{
+		steps.add(BddRelation(d0 * d1, (z[0] == i) & (z[1] == i + 1)));
+	}
+
+	BddSet s(Domain(6, 3), Bdd(space, false));
+	BddSet s_odd = BddSet(s, 1) | BddSet(s, 3) | BddSet(s, 5) | BddSet(s, 7);
+
+	BddBinaryRelation inc_rel = inc.get_relation();
+	BddBinaryRelation steps_rel = steps.get_relation();
+
+	return
+		inc.n_clusters() == 3 &&
+		inc_rel.image_under(BddSet(s, 7)) == BddSet(d1, BddSet(s, 0)) &&
+		inc.image_under(s_odd) == inc_rel.image_under(s_odd) &&
+		inc.range_under(s_odd) == inc_rel.range_under(s_odd) &&
+		inc.image_under(BddSet(s, 0, 7)) == inc_rel.image_under(BddSet(s, 0, 7)) &&
+		steps.image_under(BddSet(s, 0, 3)) == BddSet(d1, BddSet(s, 1) | BddSet(s, 3)) &&
+		steps.range_under(s_odd) == steps_rel.range_under(s_odd) &&
+		steps.range_under(BddSet(s, 2)).is_empty();
+}
+
+static bool test_saturation()
+{
+	Bdd::Vars x(space);
+	Bdd::FiniteVars z = x[Domain(0, 2) * Domain(2, 2) * Domain(4, 2)];
+	Bdd::FiniteVars w = x[Domain(10, 2) * Domain(12, 2)];
+
+	// Increment the first domain up to 3, and copy each domain to the next
+
+	Bdd inc(space, false);
+	for (unsigned int i = 0;i < 3;++i)
+	{
+		inc |= (w[0] == i) & (w[1] == i + 1);
+	}
+
+	Bdd copy = Bdd::vars_equal(space, w[0].get_domain(), w[1].get_domain());
+
+	BddSaturation saturation(z.get_domains());
+
+	vector<unsigned int> reads;
+	vector<unsigned int> writes;
+
+	reads.push_back(0);
+	writes.push_back(0);
+	saturation.add_event(reads, writes, BddRelation(w, inc));
+
+	for (unsigned int i = 1;i < 3;++i)
+	{
+		reads[0] = i - 1;
+		writes[0] = i;
+		saturation.add_event(reads, writes, BddRelation(w, copy));
+	}
+
+	Bdd expected(space, false);
+	for (unsigned int a = 0;a < 4;++a)
+	{
+		for (unsigned int b = 0;b <= a;++b)
+		{
+			for (unsigned int c = 0;c <= b;++c)
+			{
+				expected |= (z[0] == a) & (z[1] == b) & (z[2] == c);
+			}
+		}
+	}
+
+	BddRelation initial(z, (z[0] == 0) & (z[1] == 0) & (z[2] == 0));
+
+	// Counter on 5 bits, copied to a second domain
+
+	Bdd::FiniteVars c = x[Domain(20, 5) * Domain(30, 5)];
+	Bdd::FiniteVars c_w = x[Domain(40, 5) * Domain(50, 5)];
+
+	BddSaturation counter(c.get_domains());
+
+	reads[0] = 0;
+	writes[0] = 0;
+	counter.add_event(reads, writes, BddRelation(c_w, c_w[0] + 1 == c_w[1]));
+
+	writes[0] = 1;
+	counter.add_event(reads, writes, BddRelation(c_w, c_w[0] == c_w[1]));
+
+	BddRelation counter_initial(c, (c[0] == 0) & (c[1] == 0));
+
+	return
+		saturation.saturate(initial) == BddRelation(z, expected) &&
+		counter.saturate(counter_initial) == BddRelation(c, c[1] <= c[0]);
+}
+
+static bool test_compose_chain()
+{
+	Bdd::Vars x(space);
+	Bdd::FiniteVars z = x[Domain(0, 3) * Domain(3, 3)];
+	Bdd::FiniteVars w = x[Domain(10, 3) * Domain(13, 3)];
+
+	// Pairs (i, 2i), successor and predecessor modulo 8
+
+	Bdd doubled(space, false);
+	Bdd succ(space, false);
+	Bdd pred(space, false);
+	for (unsigned int i = 0;i < 8;++i)
+	{
+		doubled |= (z[0] == i) & (z[1] == ((2 * i) % 8));
+		succ |= (w[0] == i) & (w[1] == ((i + 1) % 8));
+		pred |= (w[0] == ((i + 1) % 8)) & (w[1] == i);
+	}
+
+	BddRelation r(z, doubled);
+
+	vector<BddRelation> rels;
+	rels.push_back(BddRelation(w, succ));
+	rels.push_back(BddRelation(w, succ));
+	rels.push_back(BddRelation(w, pred));
+
+	vector<unsigned int> indices;
+	indices.push_back(0);
+	indices.push_back(1);
+	indices.push_back(1);
+
+	BddRelation sequential = r.compose(0, rels[0]).compose(0, rels[1]).compose(0, rels[2]);
+	BddRelation mixed = r.compose(0, rels[0]).compose(1, rels[1]).compose(1, rels[2]);
+
+	return
+		r.compose_chain(0, rels) == sequential &&
+		r.compose_all(indices, rels) == mixed &&
+		r.compose_chain(0, vector<BddRelation>()) == r;
+}
+
+static vector<unsigned int> vals(unsigned int v1, unsigned int v2, unsigned int v3)
+{
+	vector<unsigned int> v;
+
+	v.push_back(v1);
+	v.push_back(v2);
+	v.push_back(v3);
+
+	return v;
+}
+
+static vector<unsigned int> vals(unsigned int v1, unsigned int v2, unsigned int v3, unsigned int v4)
+{
+	vector<unsigned int> v = vals(v1, v2, v3);
+
+	v.push_back(v4);
+
+	return v;
+}
+
+static bool test_join()
+{
+	BddRelation r1(space, 3);
+	BddRelation r2(space, 2);
+
+	r1.insert(vals(0, 1, 2));
+	r1.insert(vals(1, 2, 3));
+	r1.insert(vals(2, 1, 0));
+	r1.insert(vals(3, 1, 3));
+
+	r2.insert(1, 5);
+	r2.insert(2, 6);
+	r2.insert(3, 7);
+
+	BddRelation joined(space, 4);
+	joined.insert(vals(0, 1, 2, 5));
+	joined.insert(vals(1, 2, 3, 6));
+	joined.insert(vals(2, 1, 0, 5));
+	joined.insert(vals(3, 1, 3, 5));
+
+	BddRelation composed(space, 3);
+	composed.insert(vals(0, 2, 5));
+	composed.insert(vals(1, 3, 6));
+	composed.insert(vals(2, 0, 5));
+	composed.insert(vals(3, 3, 5));
+
+	BddRelation permuted(space, 3);
+	permuted.insert(vals(2, 0, 1));
+	permuted.insert(vals(3, 1, 2));
+	permuted.insert(vals(0, 2, 1));
+	permuted.insert(vals(3, 3, 1));
+
+	BddRelation projected(space, 2);
+	projected.insert(2, 0);
+	projected.insert(3, 1);
+	projected.insert(0, 2);
+	projected.insert(3, 3);
+
+	BddRelation selected(space, 3);
+	selected.insert(vals(3, 1, 3));
+
+	vector<unsigned int> on1(1, 1);
+	vector<unsigned int> on2(1, 0);
+
+	vector<unsigned int> order;
+	order.push_back(2);
+	order.push_back(0);
+	order.push_back(1);
+
+	vector<unsigned int> columns;
+	columns.push_back(2);
+	columns.push_back(0);
+
+	return
+		BddRelation::join(r1, on1, r2, on2) == joined &&
+		BddRelation::join(r1, on1, r2, on2, false) == composed &&
+		r1.permute(order) == permuted &&
+		r1.project_columns(columns) == projected &&
+		r1.select_equal(0, 2) == selected &&
+		r1.select(1, 2) == BddRelation::join(r1, on1, r2.select(1, 6), on2).project_columns(vals(0, 1, 2));
+}
+
+static bool test_expression()
+{
+	BddRelation r1(space, 3);
+	BddRelation r2(space, 3);
+
+	for (unsigned int i = 0;i < 8;++i)
+	{
+		r1.insert(vals(i, (i + 1) % 8, i / 2));
+		r2.insert(vals(i, (i + 3) % 8, i % 2));
+	}
+
+	BddSet s = BddSet(BddRelation(r1.project_on(0)), 2) | BddSet(BddRelation(r1.project_on(0)), 5);
+
+	vector<unsigned int> columns;
+	columns.push_back(2);
+	columns.push_back(0);
+
+	BddExpressionGraph graph;
+
+	BddExpression a = graph.leaf(r1);
+	BddExpression b = graph.leaf(r2);
+
+	BddExpression e1 = ((a | b) - (a & b)).restrict(0, s);
+	BddExpression e2 = (a & b).project_columns(columns).restrict(1, s);
+	vector<unsigned int> first(1, 1);
+	BddExpression e3 = (a | b).project_columns(columns).project_columns(first).adapt(Domains(Domain(40, 3))).adapt(Domains(r1.get_domain(0)));
+
+	bool ok =
+		e1.evaluate() == ((r1 | r2) - (r1 & r2)).restrict(0, s) &&
+		e2.evaluate() == (r1 & r2).project_columns(columns).restrict(1, s) &&
+		e3.evaluate() == (r1 | r2).project_columns(columns).project_columns(first) &&
+		e3.evaluate().get_domain(0) == r1.get_domain(0);
+
+	// Evaluating shared subexpressions again does no work
+
+	unsigned int n_evaluations = graph.n_evaluations();
+	BddExpression e4 = ((a | b) - (a & b)).restrict(0, s);
+
+	return
+		ok &&
+		e4.evaluate() == e1.evaluate() &&
+		graph.n_evaluations() == n_evaluations;
+}
+
+static bool test_serializer()
+{
+	Bdd::Vars x(space);
+	Bdd::FiniteVars y = x[Domain(0,5) * Domain(5,5)];
+
+	vector<BddRelation> rels;
+	rels.push_back(BddRelation(y, (y[0] == 1 | y[0] == 7) & y[1] == 3));
+	rels.push_back(BddRelation(y, y[0] == 7 | y[1] == 3));
+	rels.push_back(BddRelation(y, Bdd(space, true)));
+	rels.push_back(BddRelation(Domains(Domain::infinite(10, 2)), y[0] == 2));
+
+	ostringstream os;
+	BddSerializer::write(os, rels);
+
+	istringstream is(os.str());
+	vector<BddRelation> read_rels = BddSerializer::read_relations(is, space);
+
+	// Reading into another space and writing again gives the same file
+
+	GSpace other_space;
+	istringstream is_other(os.str());
+	vector<BddRelation> other_rels = BddSerializer::read_relations(is_other, &other_space);
+
+	ostringstream os_other;
+	BddSerializer::write(os_other, other_rels);
+
+	vector<Bdd> bdds;
+	bdds.push_back(rels[0].get_bdd());
+	bdds.push_back(Bdd(space, false));
+
+	ostringstream os_bdds;
+	BddSerializer::write(os_bdds, bdds);
+
+	istringstream is_bdds(os_bdds.str());
+	vector<Bdd> read_bdds = BddSerializer::read(is_bdds, space);
+
+	bool not_relations = false;
+	try
+	{
+		istringstream is_bdds_rel(os_bdds.str());
+		BddSerializer::read_relations(is_bdds_rel, space);
+	}
+	catch (const Space::Error& e)
+	{
+		not_relations = true;
+	}
+
+	// Huge node counts and integers wider than 64 bits are errors
+
+	string header(BddSerializer::magic, sizeof(BddSerializer::magic));
+	string huge_count = header + string("\0\0", 2) + string(8, '\xff') + "\x7f";
+	string too_wide = header + string(10, '\xff') + "\x01";
+
+	unsigned int n_malformed = 0;
+	for (unsigned int i = 0;i < 2;++i)
+	{
+		try
+		{
+			istringstream is_malformed(i == 0 ? huge_count : too_wide);
+			BddSerializer::read(is_malformed, space);
+		}
+		catch (const Space::Error& e)
+		{
+			++n_malformed;
+		}
+	}
+
+	return
+		read_rels.size() == 4 &&
+		read_rels[0] == rels[0] && read_rels[1] == rels[1] && read_rels[2] == rels[2] &&
+		read_rels[3].get_domains()[0] == Domain::infinite(10, 2) &&
+		read_rels[3].get_bdd() == rels[3].get_bdd() &&
+		other_rels[0].get_domains() == rels[0].get_domains() &&
+		os_other.str() == os.str() &&
+		read_bdds.size() == 2 && read_bdds[0] == bdds[0] && read_bdds[1].is_false() &&
+		not_relations && n_malformed == 2;
+}
+
+static bool test_frozen()
+{
+	Bdd::Vars x(space);
+	Bdd::FiniteVars y = x[Domain(0,5) * Domain(5,5)];
+
+	BddRelation r(y, (y[0] == 1 | y[0] == 7 | y[0] == 20) & (y[1] == 3 | y[1] == 30));
+	BddSet s(Domain(0,5), y[0] == 2 | y[0] == 17);
+
+	FrozenBdd frozen_r(r.get_domains(), r.get_bdd());
+	FrozenBdd frozen_s(Domain(0,5), y[0] == 2 | y[0] == 17);
+
+	for (uint32_t i = 0;i < 32;++i)
+	{
+		if (frozen_s.member(i) != s.member(i)) return false;
+
+		for (uint32_t j = 0;j < 32;++j)
+		{
+			vector<uint32_t> values;
+			values.push_back(i);
+			values.push_back(j);
+
+			if (frozen_r.member(values) != r.get_bdd().value_member(r.get_domains()[0] | r.get_domains()[1], i | (j << 5)))
+				return false;
+		}
+	}
+
+	// Values outside the domains must not alias values inside
+
+	vector<uint32_t> out_of_range;
+	out_of_range.push_back(1 + 32);
+	out_of_range.push_back(3);
+
+	if (frozen_s.member(2 + 32) || frozen_s.member(17 + (1U << 31)) || frozen_r.member(out_of_range))
+		return false;
+
+	out_of_range[0] = 1;
+	out_of_range[1] = 30 + 64;
+
+	if (frozen_r.member(out_of_range) || s.member(2 + 32)) return false;
+
+	return frozen_r.get_n_nodes() > 2;
+}
+
+static bool test_batch()
+{
+	Bdd::Vars x(space);
+	Bdd::FiniteVars y = x[Domain(0,5,2) * Domain(1,5,2)];
+
+	BddRelation r(y, ((y[0] == 1 | y[0] == 7 | y[0] == 20) & (y[1] == 3 | y[1] == 30)) | y[0] == 11);
+	BddSet s(Domain(0,5,2), y[0] == 2 | y[0] == 17);
+	BddRelation r_false(y, Bdd(space, false));
+	BddRelation r_true(y, Bdd(space, true));
+
+	vector<vector<unsigned int> > values(2);
+	vector<unsigned int> set_values;
+
+	for (unsigned int i = 0;i < 40;++i)
+	{
+		set_values.push_back(i);
+
+		for (unsigned int j = 0;j < 40;++j)
+		{
+			values[0].push_back(i);
+			values[1].push_back(j);
+		}
+	}
+
+	vector<bool> in_r = r.contains_batch(values);
+	vector<bool> in_s = s.member_batch(set_values);
+	vector<bool> in_false = r_false.contains_batch(values);
+	vector<bool> in_true = r_true.contains_batch(values);
+
+	for (unsigned int k = 0;k < values[0].size();++k)
+	{
+		unsigned int i = values[0][k];
+		unsigned int j = values[1][k];
+		bool expected = i < 32 && j < 32 &&
+			(((i == 1 || i == 7 || i == 20) && (j == 3 || j == 30)) || i == 11);
+
+		if (in_r[k] != expected || in_false[k] || in_true[k] != (i < 32 && j < 32)) return false;
+	}
+
+	for (unsigned int k = 0;k < set_values.size();++k)
+	{
+		if (in_s[k] != s.member(set_values[k])) return false;
+	}
+
+	return in_r.size() == 1600 && in_s.size() == 40;
+}
+
+static Bdd bitset_to_bdd(const StructureRelation& r)
+{
+	return dynamic_cast<const BitsetConstraint&>(r.get_bdd_based()).to_bdd(space);
+}
+
+static bool test_bitset()
+{
+	Bdd::Vars x(space);
+	Bdd::FiniteVars y = x[Domain(0,4,2) * Domain(1,4,2)];
+	Bdd::FiniteVars z = x[Domain(8,4) * Domain(12,4)];
+
+	Bdd p_succ(space, false);
+	for (unsigned int v = 0;v < 15;++v)
+	{
+		p_succ |= (y[0] == v & y[1] == v + 1);
+	}
+
+	BddRelation succ(y, p_succ);
+	BddRelation other(y, y[0] == 3 | y[1] == 5);
+	BddRelation mapper(z, (z[0] == 1 & z[1] == 9) | (z[0] == 4 & z[1] == 2));
+
+	StructureRelation bitset_succ(succ.get_domains(), BitsetConstraint(Domain(0,8), p_succ));
+	StructureRelation bitset_other(other.get_domains(), BitsetConstraint(Domain(0,8), other.get_bdd()));
+	StructureRelation bitset_mapper(mapper.get_domains(), BitsetConstraint(Domain(8,8), mapper.get_bdd()));
+
+	vector<unsigned int> swap;
+	swap.push_back(1);
+	swap.push_back(0);
+
+	BitsetConstraint c(Domain(0,8), p_succ);
+	auto_ptr<BoolConstraint> converted(c.ptr_convert(Bdd::Factory(space)));
+	auto_ptr<BoolConstraint> converted_back(succ.get_bdd().ptr_convert(BitsetConstraint::Factory()));
+
+	return
+		bitset_to_bdd(bitset_succ.transitive_closure()) == succ.transitive_closure().get_bdd() &&
+		bitset_to_bdd(bitset_succ.reflexive_transitive_closure()) ==
+		succ.reflexive_transitive_closure().get_bdd() &&
+		bitset_to_bdd(bitset_succ | bitset_other) == (succ | other).get_bdd() &&
+		bitset_to_bdd(bitset_succ - bitset_other) == (succ - other).get_bdd() &&
+		bitset_to_bdd(!bitset_other) == (!other).get_bdd() &&
+		bitset_to_bdd(bitset_succ.compose(1, bitset_mapper)) == succ.compose(1, mapper).get_bdd() &&
+		bitset_to_bdd(bitset_succ.permute(swap)) == succ.permute(swap).get_bdd() &&
+		bitset_to_bdd(bitset_succ.project(0)) == BddRelation(succ.project(0)).get_bdd() &&
+		bitset_succ.select_equal(0, 1) == StructureRelation(succ.get_domains(), BitsetConstraint(false)) &&
+		bitset_other.get_bdd_based().highest_var() == other.get_bdd().highest_var() &&
+		bitset_other.get_bdd_based().lowest_var() == other.get_bdd().lowest_var() &&
+		BitsetConstraint(Domain(0,8), c.to_bdd(space)) == c &&
+		dynamic_cast<const Bdd&>(*converted) == p_succ &&
+		dynamic_cast<const BitsetConstraint&>(*converted_back) == c;
+}
+
+static bool test_adaptive_set()
+{
+	for (unsigned int n_vars = 10;n_vars <= 20;n_vars += 10)
+	{
+		AdaptiveSet evens(space, Domain(0, n_vars));
+		AdaptiveSet few(space, Domain(0, n_vars));
+		BddSet bdd_evens(Domain(0, n_vars), Bdd(space, false));
+
+		for (unsigned int v = 0;v < 600;v += 2)
+		{
+			evens.insert(v);
+			bdd_evens.insert(v);
+		}
+
+		for (unsigned int v = 0;v < 40;v += 1)
+		{
+			few.insert(v);
+		}
+
+		AdaptiveSet::Encoding large_encoding =
+			n_vars <= AdaptiveSet::max_bitset_vars ?
+			AdaptiveSet::ENCODING_BITSET :
+			AdaptiveSet::ENCODING_BDD;
+
+		AdaptiveSet common = evens & few;
+		AdaptiveSet joined = evens | few;
+		AdaptiveSet from_bdd(BddSet(Domain(0, n_vars), bdd_evens));
+
+		if (evens.get_encoding() != large_encoding ||
+		    few.get_encoding() != AdaptiveSet::ENCODING_SORTED ||
+		    common.get_encoding() != AdaptiveSet::ENCODING_SORTED ||
+		    from_bdd.get_encoding() != large_encoding ||
+		    (few - evens).get_encoding() != AdaptiveSet::ENCODING_SORTED)
+		{
+			return false;
+		}
+
+		if (evens.size() != 300 || common.size() != 20 || joined.size() != 320 ||
+		    (few - evens).size() != 20 || !(evens - evens).is_empty() ||
+		    !evens.member(598) || evens.member(599) || !(few - evens).member(39) ||
+		    evens.member(4 + (1U << n_vars)) || few.member(4 + (1U << n_vars)) ||
+		    from_bdd != evens || joined == evens || (joined - few) != (evens - few))
+		{
+			return false;
+		}
+
+		if (!(evens.get_bdd_set() == bdd_evens) ||
+		    !(joined.get_bdd_set() == (bdd_evens | few.get_bdd_set())) ||
+		    common.get_values().size() != 20 || common.get_values()[19] != 38)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+static bool test_zdd()
+{
+	ZddSpace zdd_space;
+
+	Zdd a = Zdd::single(&zdd_space, Domain(0, 2)) | Zdd::single(&zdd_space, 2);
+	Zdd b = Zdd::single(&zdd_space, 2) | Zdd::base(&zdd_space);
+
+	if ((a & b) != Zdd::single(&zdd_space, 2) ||
+	    (a - b) != Zdd::single(&zdd_space, Domain(0, 2)) ||
+	    (a | b).count() != 3 ||
+	    a.change(2) != (Zdd::single(&zdd_space, Domain(0, 3)) | Zdd::base(&zdd_space)) ||
+	    a.subset1(2) != Zdd::base(&zdd_space) ||
+	    a.subset0(2) != Zdd::single(&zdd_space, Domain(0, 2)) ||
+	    !(a - a).is_empty())
+	{
+		return false;
+	}
+
+	Bdd::Vars x(space);
+	Bdd::FiniteVars y = x[Domain(0,16) * Domain(16,16)];
+
+	Bdd p_rotate(space, false);
+	for (unsigned int i = 0;i < 16;++i)
+	{
+		p_rotate |= (y[0] == (1U << i) & y[1] == (1U << ((i + 1) % 16)));
+	}
+
+	BddRelation rotate(y, p_rotate);
+	BddRelation first(y, y[0] == 1 & y[1] == 2);
+
+	Zdd z_rotate = Zdd::from_relation(&zdd_space, rotate);
+	Zdd z_first = Zdd::from_relation(&zdd_space, first);
+
+	return
+		z_rotate.count() == 16 &&
+		z_rotate.get_n_nodes() <= 2 * 16 + 2 &&
+		z_rotate.to_relation(space, rotate.get_domains()) == rotate &&
+		(z_rotate - z_first).to_relation(space, rotate.get_domains()) == rotate - first &&
+		(z_rotate & z_first) == z_first &&
+		z_rotate.subset1(0).subset1(17) == Zdd::base(&zdd_space);
+}
+
+static bool test_add()
+{
+	AddSpace add_space;
+
+	Bdd::Vars x(space);
+	Bdd::FiniteVars y = x[Domain(0,4,2) * Domain(1,4,2)];
+
+	Bdd p_below(space, false);
+	for (unsigned int a = 0;a < 10;++a)
+	{
+		p_below |= (y[0] == a & Bdd::value_range(space, Domain(1,4,2), 0, a));
+	}
+
+	Add counts = Add::from_bdd(&add_space, p_below).sum(Domain(1,4,2));
+
+	for (unsigned int a = 0;a < 16;++a)
+	{
+		if (counts.evaluate(Domain(0,4,2), a) != (a < 10 ? a + 1 : 0)) return false;
+	}
+
+	Add w1 = Add::from_bdd(&add_space, y[0] == 3, 7);
+	Add w2 = Add::from_bdd(&add_space, y[1] == 2, 5);
+	Add one = Add::constant(&add_space, 1);
+
+	// NaN from infinity times zero has the one NaN leaf
+
+	Add infinity = Add::constant(&add_space, numeric_limits<double>::infinity());
+	Add zero = Add::constant(&add_space, 0);
+	Add nan = infinity * zero;
+
+	return
+		nan == Add::constant(&add_space, numeric_limits<double>::quiet_NaN()) &&
+		!(nan == zero) && !(nan == infinity) &&
+		Add::min(nan, one) == Add::min(one, nan) &&
+		counts.threshold(space, 5) == Bdd::value_range(space, Domain(0,4,2), 4, 9) &&
+		(w1 + w2).maximum(Domain(0,8)) == Add::constant(&add_space, 12) &&
+		Add::max(w1, w2).maximum(Domain(0,8)) == Add::constant(&add_space, 7) &&
+		Add::min(w1, w2).threshold(space, 5) == (y[0] == 3 & y[1] == 2) &&
+		Add::max(w1, w2).threshold(space, 5) == (y[0] == 3 | y[1] == 2) &&
+		(w1 * w2).threshold(space, 35) == (y[0] == 3 & y[1] == 2) &&
+		one.sum(Domain(0,8)) == Add::constant(&add_space, 256) &&
+		(w1 + one).threshold(space, 8) == (y[0] == 3);
+}
+
 int main(int argc, char **argv)
 {
 	struct
@@ -250,7 +973,21 @@ int main(int argc, char **argv)
 		{"Relations insert", test_relations_insert},
 		{"Identity relation", test_identity},
 		{"Equivalence relation", test_equivalence},
-		{"Infinite domains", test_infinite}
+		{"Infinite domains", test_infinite},
+		{"Reachability", test_reachability},
+		{"Transitive closure", test_closure},
+		{"Partitioned relation", test_partitioned},
+		{"Saturation", test_saturation},
+		{"Compose chain", test_compose_chain},
+		{"Join", test_join},
+		{"Expressions", test_expression},
+		{"Serialization", test_serializer},
+		{"Frozen BDD", test_frozen},
+		{"Batch evaluation", test_batch},
+		{"Bitset constraint", test_bitset},
+		{"Adaptive set", test_adaptive_set},
+		{"ZDD", test_zdd},
+		{"ADD", test_add}
 	};
 
 	unsigned int i;
@@ -0,0 +1,810 @@
+/*
+ * tracing-space.cc:
+ *
+ * Copyright (C) 2004 Marcus Nilsson (marcusn@it.uu.se)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Authors:
+ *    Marcus Nilsson (marcusn@it.uu.se)
+ */
+
+#include <gbdd/tracing-space.h>
+#include <gbdd/domain.h>
+#include <sys/time.h>
+#include <string.h>
+
+namespace gbdd
+{
+
+const char TracingSpace::magic[8] = { 'G', 'B', 'D', 'D', 'T', 'R', 'C', '1' };
+
+static unsigned char fn_to_truth_table(Space::ProductFunction& fn)
+{
+	unsigned char index = 0;
+
+	if (fn(true, true)) index |= 0x08;
+	if (fn(true, false)) index |= 0x04;
+	if (fn(false, true)) index |= 0x02;
+	if (fn(false, false)) index |= 0x01;
+
+	return index;
+}
+
+static unsigned char fn_to_truth_table(Space::UnaryProductFunction& fn)
+{
+	unsigned char index = 0;
+
+	if (fn(true)) index |= 0x02;
+	if (fn(false)) index |= 0x01;
+
+	return index;
+}
+
+/// Constructor
+/**
+ * @param space Space to trace, the tracing space takes ownership of it
+ * @param filename File to write trace to
+ */
+TracingSpace::TracingSpace(auto_ptr<Space> space, const string& filename):
+	space(space),
+	trace(filename.c_str(), ios::out | ios::binary | ios::trunc),
+	next_id(0),
+	n_vars(0)
+{
+	if (!trace)
+	{
+		throw Error("could not open trace file " + filename);
+	}
+
+	trace.write(magic, sizeof(magic));
+}
+
+TracingSpace::~TracingSpace()
+{
+	trace.close();
+}
+
+/// Flush trace file
+void TracingSpace::flush()
+{
+	trace.flush();
+}
+
+void TracingSpace::write_op(Operation op)
+{
+	trace.put((char)op);
+}
+
+void TracingSpace::write_uint(unsigned long int v)
+{
+	while (v >= 0x80)
+	{
+		trace.put((char)((v & 0x7f) | 0x80));
+		v >>= 7;
+	}
+
+	trace.put((char)v);
+}
+
+void TracingSpace::write_bdd(Bdd p)
+{
+	hash_map<Bdd, unsigned long int>::const_iterator i = ids.find(p);
+
+	if (i == ids.end())
+	{
+		throw Error("BDD not created in traced space");
+	}
+
+	write_uint(i->second);
+}
+
+void TracingSpace::write_result(Bdd p)
+{
+	hash_map<Bdd, unsigned long int>::iterator i = ids.find(p);
+
+	if (i == ids.end())
+	{
+		i = ids.insert(pair<const Bdd, unsigned long int>(p, next_id++)).first;
+	}
+
+	write_uint(i->second);
+}
+
+void TracingSpace::write_var(Var v)
+{
+	if (v >= n_vars) n_vars = v + 1;
+
+	write_uint(v);
+}
+
+/// Write variable predicate
+/**
+ * The predicate is written as the number of variables satisfying it, followed
+ * by the variables as differences to the previous variable
+ */
+void TracingSpace::write_vars(VarPredicate& fn_var)
+{
+	vector<Var> vars;
+	for (Var v = 0;v < n_vars;++v)
+	{
+		if (fn_var(v)) vars.push_back(v);
+	}
+
+	write_uint(vars.size());
+
+	Var previous = 0;
+	for (vector<Var>::const_iterator i = vars.begin();i != vars.end();++i)
+	{
+		write_uint(*i - previous);
+		previous = *i;
+	}
+}
+
+void TracingSpace::gc()
+{
+	write_op(TRACE_GC);
+	space->gc();
+}
+
+void TracingSpace::lock_gc()
+{
+	write_op(TRACE_LOCK_GC);
+	space->lock_gc();
+}
+
+void TracingSpace::unlock_gc()
+{
+	write_op(TRACE_UNLOCK_GC);
+	space->unlock_gc();
+}
+
+void TracingSpace::bdd_ref(Bdd p)
+{
+	write_op(TRACE_REF);
+	write_bdd(p);
+
+	space->bdd_ref(p);
+}
+
+void TracingSpace::bdd_unref(Bdd p)
+{
+	write_op(TRACE_UNREF);
+	write_bdd(p);
+
+	space->bdd_unref(p);
+}
+
+bool TracingSpace::bdd_is_leaf(Bdd p)
+{
+	write_op(TRACE_IS_LEAF);
+	write_bdd(p);
+
+	return space->bdd_is_leaf(p);
+}
+
+bool TracingSpace::bdd_leaf_value(Bdd p)
+{
+	write_op(TRACE_LEAF_VALUE);
+	write_bdd(p);
+
+	return space->bdd_leaf_value(p);
+}
+
+Space::Bdd TracingSpace::bdd_then(Bdd p)
+{
+	Bdd res = space->bdd_then(p);
+
+	write_op(TRACE_THEN);
+	write_bdd(p);
+	write_result(res);
+
+	return res;
+}
+
+Space::Bdd TracingSpace::bdd_else(Bdd p)
+{
+	Bdd res = space->bdd_else(p);
+
+	write_op(TRACE_ELSE);
+	write_bdd(p);
+	write_result(res);
+
+	return res;
+}
+
+Space::Var TracingSpace::bdd_var(Bdd p)
+{
+	write_op(TRACE_VAR);
+	write_bdd(p);
+
+	return space->bdd_var(p);
+}
+
+Space::Bdd TracingSpace::bdd_leaf(bool v)
+{
+	Bdd res = space->bdd_leaf(v);
+
+	write_op(TRACE_LEAF);
+	write_uint(v ? 1 : 0);
+	write_result(res);
+
+	return res;
+}
+
+Space::Bdd TracingSpace::bdd_var_true(Var v)
+{
+	Bdd res = space->bdd_var_true(v);
+
+	write_op(TRACE_VAR_TRUE);
+	write_var(v);
+	write_result(res);
+
+	return res;
+}
+
+Space::Bdd TracingSpace::bdd_var_false(Var v)
+{
+	Bdd res = space->bdd_var_false(v);
+
+	write_op(TRACE_VAR_FALSE);
+	write_var(v);
+	write_result(res);
+
+	return res;
+}
+
+Space::Bdd TracingSpace::bdd_var_then_else(Var v, Bdd p_then, Bdd p_else)
+{
+	Bdd res = space->bdd_var_then_else(v, p_then, p_else);
+
+	write_op(TRACE_VAR_THEN_ELSE);
+	write_var(v);
+	write_bdd(p_then);
+	write_bdd(p_else);
+	write_result(res);
+
+	return res;
+}
+
+Space::Var TracingSpace::bdd_highest_var(Bdd p)
+{
+	write_op(TRACE_HIGHEST_VAR);
+	write_bdd(p);
+
+	return space->bdd_highest_var(p);
+}
+
+/// Project BDD
+/**
+ * The variable predicate is recorded as the set of variables below the highest variable
+ * used so far in the trace that satisfy it
+ */
+Space::Bdd TracingSpace::bdd_project(Bdd p, VarPredicate& fn_var, ProductFunction& fn_prod)
+{
+	Bdd res = space->bdd_project(p, fn_var, fn_prod);
+
+	write_op(TRACE_PROJECT);
+	write_bdd(p);
+	write_uint(fn_to_truth_table(fn_prod));
+	write_vars(fn_var);
+	write_result(res);
+
+	return res;
+}
+
+Space::Bdd TracingSpace::bdd_forall(Bdd p, VarPredicate& fn_var)
+{
+	Bdd res = space->bdd_forall(p, fn_var);
+
+	write_op(TRACE_FORALL);
+	write_bdd(p);
+	write_vars(fn_var);
+	write_result(res);
+
+	return res;
+}
+
+Space::Bdd TracingSpace::bdd_unique(Bdd p, VarPredicate& fn_var)
+{
+	Bdd res = space->bdd_unique(p, fn_var);
+
+	write_op(TRACE_UNIQUE);
+	write_bdd(p);
+	write_vars(fn_var);
+	write_result(res);
+
+	return res;
+}
+
+Space::Bdd TracingSpace::bdd_rename(Bdd p, const VarMap& fn)
+{
+	Bdd res = space->bdd_rename(p, fn);
+
+	write_op(TRACE_RENAME);
+	write_bdd(p);
+	write_uint(fn.size());
+
+	for (VarMap::const_iterator i = fn.begin();i != fn.end();++i)
+	{
+		write_var(i->first);
+		write_var(i->second);
+	}
+
+	write_result(res);
+
+	return res;
+}
+
+Space::Bdd TracingSpace::bdd_product(Bdd p, Bdd q, ProductFunction& fn)
+{
+	Bdd res = space->bdd_product(p, q, fn);
+
+	write_op(TRACE_PRODUCT);
+	write_bdd(p);
+	write_bdd(q);
+	write_uint(fn_to_truth_table(fn));
+	write_result(res);
+
+	return res;
+}
+
+Space::Bdd TracingSpace::bdd_product(Bdd p, UnaryProductFunction& fn)
+{
+	Bdd res = space->bdd_product(p, fn);
+
+	write_op(TRACE_UNARY_PRODUCT);
+	write_bdd(p);
+	write_uint(fn_to_truth_table(fn));
+	write_result(res);
+
+	return res;
+}
+
+Space::Bdd TracingSpace::bdd_and_project(Bdd p, Bdd q, VarPredicate& fn_var)
+{
+	Bdd res = space->bdd_and_project(p, q, fn_var);
+
+	write_op(TRACE_AND_PROJECT);
+	write_bdd(p);
+	write_bdd(q);
+	write_vars(fn_var);
+	write_result(res);
+
+	return res;
+}
+
+bool TracingSpace::bdd_intersects(Bdd p, Bdd q)
+{
+	write_op(TRACE_INTERSECTS);
+	write_bdd(p);
+	write_bdd(q);
+
+	return space->bdd_intersects(p, q);
+}
+
+bool TracingSpace::bdd_implies(Bdd p, Bdd q)
+{
+	write_op(TRACE_IMPLIES);
+	write_bdd(p);
+	write_bdd(q);
+
+	return space->bdd_implies(p, q);
+}
+
+Space::Bdd TracingSpace::bdd_restrict(Bdd p, Bdd care)
+{
+	Bdd res = space->bdd_restrict(p, care);
+
+	write_op(TRACE_RESTRICT);
+	write_bdd(p);
+	write_bdd(care);
+	write_result(res);
+
+	return res;
+}
+
+Space::Bdd TracingSpace::bdd_constrain(Bdd p, Bdd care)
+{
+	Bdd res = space->bdd_constrain(p, care);
+
+	write_op(TRACE_CONSTRAIN);
+	write_bdd(p);
+	write_bdd(care);
+	write_result(res);
+
+	return res;
+}
+
+Space::Bdd TracingSpace::bdd_compose(Bdd p, Var v, Bdd g)
+{
+	Bdd res = space->bdd_compose(p, v, g);
+
+	write_op(TRACE_COMPOSE);
+	write_bdd(p);
+	write_var(v);
+	write_bdd(g);
+	write_result(res);
+
+	return res;
+}
+
+Space::Bdd TracingSpace::bdd_vector_compose(Bdd p, const VarBddMap& fn)
+{
+	Bdd res = space->bdd_vector_compose(p, fn);
+
+	write_op(TRACE_VECTOR_COMPOSE);
+	write_bdd(p);
+	write_uint(fn.size());
+
+	for (VarBddMap::const_iterator i = fn.begin();i != fn.end();++i)
+	{
+		write_var(i->first);
+		write_bdd(i->second);
+	}
+
+	write_result(res);
+
+	return res;
+}
+
+void TracingSpace::bdd_print(ostream &os, Bdd p) { space->bdd_print(os, p); }
+
+unsigned int TracingSpace::get_n_nodes(void) const { return space->get_n_nodes(); }
+void TracingSpace::print_statistics(ostream& os) const { space->print_statistics(os); }
+
+/*
+ * Product functions given by truth tables
+ */
+
+class TruthTableFunction
+{
+	unsigned int table;
+public:
+	TruthTableFunction(unsigned int table) : table(table) {}
+
+	bool operator()(bool v1, bool v2) const
+	{
+		return (table & (1 << ((v1 ? 2 : 0) | (v2 ? 1 : 0)))) != 0;
+	}
+};
+
+class UnaryTruthTableFunction
+{
+	unsigned int table;
+public:
+	UnaryTruthTableFunction(unsigned int table) : table(table) {}
+
+	bool operator()(bool v) const
+	{
+		return (table & (v ? 0x02 : 0x01)) != 0;
+	}
+};
+
+/// Constructor
+/**
+ * Sampling the number of nodes after every operation is included in the
+ * measured time, and clears the dead nodes of some spaces, so time replays
+ * without it.
+ *
+ * @param space Space to replay traces in
+ * @param sample_nodes Whether to sample the peak number of nodes after every operation
+ */
+TraceReplay::TraceReplay(Space* space, bool sample_nodes):
+	space(space),
+	sample_nodes(sample_nodes),
+	trace(0)
+{}
+
+unsigned long int TraceReplay::read_uint()
+{
+	unsigned long int v = 0;
+	unsigned int shift = 0;
+	int c;
+
+	do
+	{
+		c = trace->get();
+
+		if (c == EOF) throw Space::Error("unexpected end of trace");
+
+		v |= ((unsigned long int)(c & 0x7f)) << shift;
+		shift += 7;
+	}
+	while (c & 0x80);
+
+	return v;
+}
+
+Space::Bdd TraceReplay::read_bdd()
+{
+	return get_bdd(read_uint());
+}
+
+Domain TraceReplay::read_vars()
+{
+	unsigned long int n_vars = read_uint();
+
+	Domain vars;
+	Space::Var v = 0;
+	while (n_vars > 0)
+	{
+		v += read_uint();
+		vars |= Domain(v);
+		--n_vars;
+	}
+
+	return vars;
+}
+
+void TraceReplay::set_result(Space::Bdd p)
+{
+	unsigned long int id = read_uint();
+
+	if (id >= bdds.size()) bdds.resize(id + 1);
+
+	bdds[id] = p;
+}
+
+/// Get BDD of identity
+/**
+ * @param id Identity in trace
+ *
+ * @return The BDD in the replay space that \a id was last assigned to
+ */
+Space::Bdd TraceReplay::get_bdd(unsigned long int id) const
+{
+	if (id >= bdds.size()) throw Space::Error("unknown BDD in trace");
+
+	return bdds[id];
+}
+
+/// Replay trace
+/**
+ * Replays all operations in a trace, measuring the time spent. The peak number
+ * of nodes is sampled after every operation if asked for in the constructor,
+ * otherwise it is the number of nodes after the replay.
+ *
+ * @param trace Stream to read trace from
+ *
+ * @return Statistics of the replay
+ */
+TraceReplay::Statistics TraceReplay::replay(istream& trace)
+{
+	this->trace = &trace;
+
+	char header[sizeof(TracingSpace::magic)];
+	trace.read(header, sizeof(header));
+
+	if (!trace || memcmp(header, TracingSpace::magic, sizeof(header)) != 0)
+	{
+		throw Space::Error("not a trace");
+	}
+
+	Statistics stats;
+
+	struct timeval start;
+	gettimeofday(&start, NULL);
+
+	int c;
+	while ((c = trace.get()) != EOF)
+	{
+		switch ((TracingSpace::Operation)c)
+		{
+		case TracingSpace::TRACE_GC:
+			space->gc();
+			break;
+		case TracingSpace::TRACE_LOCK_GC:
+			space->lock_gc();
+			break;
+		case TracingSpace::TRACE_UNLOCK_GC:
+			space->unlock_gc();
+			break;
+		case TracingSpace::TRACE_REF:
+			space->bdd_ref(read_bdd());
+			break;
+		case TracingSpace::TRACE_UNREF:
+			space->bdd_unref(read_bdd());
+			break;
+		case TracingSpace::TRACE_IS_LEAF:
+			(void)space->bdd_is_leaf(read_bdd());
+			break;
+		case TracingSpace::TRACE_LEAF_VALUE:
+			(void)space->bdd_leaf_value(read_bdd());
+			break;
+		case TracingSpace::TRACE_THEN:
+			set_result(space->bdd_then(read_bdd()));
+			break;
+		case TracingSpace::TRACE_ELSE:
+			set_result(space->bdd_else(read_bdd()));
+			break;
+		case TracingSpace::TRACE_VAR:
+			(void)space->bdd_var(read_bdd());
+			break;
+		case TracingSpace::TRACE_LEAF:
+			set_result(space->bdd_leaf(read_uint() != 0));
+			break;
+		case TracingSpace::TRACE_VAR_TRUE:
+			set_result(space->bdd_var_true(read_uint()));
+			break;
+		case TracingSpace::TRACE_VAR_FALSE:
+			set_result(space->bdd_var_false(read_uint()));
+			break;
+		case TracingSpace::TRACE_VAR_THEN_ELSE:
+		{
+			Space::Var v = read_uint();
+			Space::Bdd p_then = read_bdd();
+			Space::Bdd p_else = read_bdd();
+
+			set_result(space->bdd_var_then_else(v, p_then, p_else));
+			break;
+		}
+		case TracingSpace::TRACE_HIGHEST_VAR:
+			(void)space->bdd_highest_var(read_bdd());
+			break;
+		case TracingSpace::TRACE_PROJECT:
+		{
+			Space::Bdd p = read_bdd();
+			TruthTableFunction fn_prod(read_uint());
+			Domain vars = read_vars();
+
+			set_result(space->bdd_project(p, vars, fn_prod));
+			break;
+		}
+		case TracingSpace::TRACE_AND_PROJECT:
+		{
+			Space::Bdd p = read_bdd();
+			Space::Bdd q = read_bdd();
+			Domain vars = read_vars();
+
+			set_result(space->bdd_and_project(p, q, vars));
+			break;
+		}
+		case TracingSpace::TRACE_INTERSECTS:
+		{
+			Space::Bdd p = read_bdd();
+			Space::Bdd q = read_bdd();
+
+			(void)space->bdd_intersects(p, q);
+			break;
+		}
+		case TracingSpace::TRACE_IMPLIES:
+		{
+			Space::Bdd p = read_bdd();
+			Space::Bdd q = read_bdd();
+
+			(void)space->bdd_implies(p, q);
+			break;
+		}
+		case TracingSpace::TRACE_RESTRICT:
+		{
+			Space::Bdd p = read_bdd();
+			Space::Bdd care = read_bdd();
+
+			set_result(space->bdd_restrict(p, care));
+			break;
+		}
+		case TracingSpace::TRACE_CONSTRAIN:
+		{
+			Space::Bdd p = read_bdd();
+			Space::Bdd care = read_bdd();
+
+			set_result(space->bdd_constrain(p, care));
+			break;
+		}
+		case TracingSpace::TRACE_COMPOSE:
+		{
+			Space::Bdd p = read_bdd();
+			Space::Var v = read_uint();
+			Space::Bdd g = read_bdd();
+
+			set_result(space->bdd_compose(p, v, g));
+			break;
+		}
+		case TracingSpace::TRACE_VECTOR_COMPOSE:
+		{
+			Space::Bdd p = read_bdd();
+			unsigned long int n_pairs = read_uint();
+
+			Space::VarBddMap map;
+			while (n_pairs > 0)
+			{
+				Space::Var v = read_uint();
+
+				map[v] = read_bdd();
+				--n_pairs;
+			}
+
+			set_result(space->bdd_vector_compose(p, map));
+			break;
+		}
+		case TracingSpace::TRACE_FORALL:
+		{
+			Space::Bdd p = read_bdd();
+			Domain vars = read_vars();
+
+			set_result(space->bdd_forall(p, vars));
+			break;
+		}
+		case TracingSpace::TRACE_UNIQUE:
+		{
+			Space::Bdd p = read_bdd();
+			Domain vars = read_vars();
+
+			set_result(space->bdd_unique(p, vars));
+			break;
+		}
+		case TracingSpace::TRACE_RENAME:
+		{
+			Space::Bdd p = read_bdd();
+			unsigned long int n_pairs = read_uint();
+
+			Space::VarMap map;
+			while (n_pairs > 0)
+			{
+				Space::Var from = read_uint();
+				Space::Var to = read_uint();
+
+				map[from] = to;
+				--n_pairs;
+			}
+
+			set_result(space->bdd_rename(p, map));
+			break;
+		}
+		case TracingSpace::TRACE_PRODUCT:
+		{
+			Space::Bdd p = read_bdd();
+			Space::Bdd q = read_bdd();
+			TruthTableFunction fn(read_uint());
+
+			set_result(space->bdd_product(p, q, fn));
+			break;
+		}
+		case TracingSpace::TRACE_UNARY_PRODUCT:
+		{
+			Space::Bdd p = read_bdd();
+			UnaryTruthTableFunction fn(read_uint());
+
+			set_result(space->bdd_product(p, fn));
+			break;
+		}
+		default:
+			throw Space::Error("unknown operation in trace");
+		}
+
+		stats.n_operations++;
+
+		if (sample_nodes)
+		{
+			unsigned int n_nodes = space->get_n_nodes();
+			if (n_nodes > stats.peak_nodes) stats.peak_nodes = n_nodes;
+		}
+	}
+
+	struct timeval stop;
+	gettimeofday(&stop, NULL);
+
+	unsigned int n_nodes = space->get_n_nodes();
+	if (n_nodes > stats.peak_nodes) stats.peak_nodes = n_nodes;
+
+	stats.seconds = (stop.tv_sec - start.tv_sec) + (stop.tv_usec - start.tv_usec) / 1000000.0;
+
+	this->trace = 0;
+
+	return stats;
+}
+
+}
@@ -0,0 +1,178 @@
+/*
+ * tracing-space.h:
+ *
+ * Copyright (C) 2004 Marcus Nilsson (marcusn@it.uu.se)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Authors:
+ *    Marcus Nilsson (marcusn@it.uu.se)
+ */
+
+#ifndef GBDD_TRACING_SPACE_H
+#define GBDD_TRACING_SPACE_H
+
+#include <gbdd/space.h>
+#include <memory>
+#include <fstream>
+
+namespace gbdd
+{
+	/// A wrapper space that logs every call to a binary trace file
+	/**
+	 * BDDs in the trace are identified by numbers that are independent of
+	 * the traced space, so a trace can be replayed with gbdd::TraceReplay in any
+	 * other space. Each record in the trace is an operation code followed by its
+	 * operands encoded as variable length unsigned integers. Operations returning
+	 * a BDD also record the identity given to the result.
+	 *
+	 * Identities are kept across garbage collections, since handles to
+	 * nodes below referenced nodes stay valid. If the traced space reuses
+	 * a freed handle for a new node, the result record of that node binds
+	 * the old identity to it again.
+	 */
+	class TracingSpace : public gbdd::Space
+	{
+	public:
+		/// Operation codes in traces
+		enum Operation
+		{
+			TRACE_GC = 1,
+			TRACE_LOCK_GC,
+			TRACE_UNLOCK_GC,
+			TRACE_REF,
+			TRACE_UNREF,
+			TRACE_IS_LEAF,
+			TRACE_LEAF_VALUE,
+			TRACE_THEN,
+			TRACE_ELSE,
+			TRACE_VAR,
+			TRACE_LEAF,
+			TRACE_VAR_TRUE,
+			TRACE_VAR_FALSE,
+			TRACE_VAR_THEN_ELSE,
+			TRACE_HIGHEST_VAR,
+			TRACE_PROJECT,
+			TRACE_RENAME,
+			TRACE_PRODUCT,
+			TRACE_UNARY_PRODUCT,
+			TRACE_AND_PROJECT,
+			TRACE_INTERSECTS,
+			TRACE_IMPLIES,
+			TRACE_RESTRICT,
+			TRACE_CONSTRAIN,
+			TRACE_COMPOSE,
+			TRACE_VECTOR_COMPOSE,
+			TRACE_FORALL,
+			TRACE_UNIQUE
+		};
+
+		static const char magic[8];
+	private:
+		auto_ptr<Space> space;
+		ofstream trace;
+
+		hash_map<Bdd, unsigned long int> ids;
+		unsigned long int next_id;
+		Var n_vars;
+
+		void write_op(Operation op);
+		void write_uint(unsigned long int v);
+		void write_bdd(Bdd p);
+		void write_result(Bdd p);
+		void write_var(Var v);
+		void write_vars(VarPredicate& fn_var);
+	public:
+		TracingSpace(auto_ptr<Space> space, const string& filename);
+		virtual ~TracingSpace();
+
+		void flush();
+
+		void gc();
+
+		void lock_gc();
+		void unlock_gc();
+
+		void bdd_ref(Bdd p);
+		void bdd_unref(Bdd p);
+
+		bool bdd_is_leaf(Bdd p);
+
+		bool bdd_leaf_value(Bdd p);
+
+		Bdd bdd_then(Bdd p);
+		Bdd bdd_else(Bdd p);
+		Var bdd_var(Bdd p);
+
+		Bdd bdd_leaf(bool v);
+		Bdd bdd_var_true(Var v);
+		Bdd bdd_var_false(Var v);
+		Bdd bdd_var_then_else(Var v, Bdd p_then, Bdd p_else);
+
+		Var bdd_highest_var(Bdd p);
+		Bdd bdd_project(Bdd p, VarPredicate& fn_var, ProductFunction& fn_prod);
+		Bdd bdd_rename(Bdd p, const VarMap& fn);
+		Bdd bdd_product(Bdd p, Bdd q, ProductFunction& fn);
+		Bdd bdd_product(Bdd p, UnaryProductFunction& fn);
+		Bdd bdd_and_project(Bdd p, Bdd q, VarPredicate& fn_var);
+		Bdd bdd_forall(Bdd p, VarPredicate& fn_var);
+		Bdd bdd_unique(Bdd p, VarPredicate& fn_var);
+		bool bdd_intersects(Bdd p, Bdd q);
+		bool bdd_implies(Bdd p, Bdd q);
+		Bdd bdd_restrict(Bdd p, Bdd care);
+		Bdd bdd_constrain(Bdd p, Bdd care);
+		Bdd bdd_compose(Bdd p, Var v, Bdd g);
+		Bdd bdd_vector_compose(Bdd p, const VarBddMap& fn);
+
+		void bdd_print(ostream &os, Bdd p);
+
+		unsigned int get_n_nodes(void) const;
+		void print_statistics(ostream& os) const;
+	};
+
+	/// Replays a trace written by gbdd::TracingSpace in some space
+	class TraceReplay
+	{
+		Space* space;
+		bool sample_nodes;
+		vector<Space::Bdd> bdds;
+
+		istream* trace;
+
+		unsigned long int read_uint();
+		Space::Bdd read_bdd();
+		Domain read_vars();
+		void set_result(Space::Bdd p);
+	public:
+		/// Statistics of a replay
+		class Statistics
+		{
+		public:
+			unsigned long int n_operations;
+			double seconds;
+			unsigned int peak_nodes;
+
+			Statistics() : n_operations(0), seconds(0), peak_nodes(0) {}
+		};
+
+		TraceReplay(Space* space, bool sample_nodes = false);
+
+		Statistics replay(istream& trace);
+
+		Space::Bdd get_bdd(unsigned long int id) const;
+	};
+}
+
+#endif /* GBDD_TRACING_SPACE_H */
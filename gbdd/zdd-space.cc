@@ -0,0 +1,354 @@
+/*
+ * zdd-space.cc: 
+ *
+ * Copyright (C) 2004 Marcus Nilsson (marcusn@it.uu.se)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ * 
+ * Authors:
+ *    Marcus Nilsson (marcusn@it.uu.se)
+ */
+
+
+#include <gbdd/zdd-space.h>
+#include <iostream>
+
+namespace gbdd
+{
+
+/// Constructor
+ZddSpace::ZddSpace():
+	nodes(N_OPERATIONS)
+{
+	nodes.leaf(false);
+	nodes.leaf(true);
+}
+
+/// Garbage collection
+/**
+ * Nodes are never freed, only the operation caches are emptied
+ */
+void ZddSpace::gc()
+{
+	nodes.clear_op_caches();
+}
+
+/// Create node
+/**
+ * Applies the zero-suppression rule, a node with the empty family as
+ * then-branch is its else-branch.
+ *
+ * @param v Variable of node, lower than the variables of \a p_then and \a p_else
+ * @param p_then Sets containing \a v, with \a v removed
+ * @param p_else Sets not containing \a v
+ * 
+ * @return The ZDD of the sets of \a p_else and the sets of \a p_then with \a v added
+ */
+ZddSpace::Zdd ZddSpace::zdd_var_then_else(Var v, Zdd p_then, Zdd p_else)
+{
+	if (p_then == zdd_empty()) return p_else;
+
+	return nodes.var_then_else(v, p_then, p_else);
+}
+
+/// Family of a singleton set
+/**
+ * @param v Variable
+ * 
+ * @return The ZDD with only the set {v}
+ */
+ZddSpace::Zdd ZddSpace::zdd_single(Var v)
+{
+	return zdd_var_then_else(v, zdd_base(), zdd_empty());
+}
+
+/// Apply set operation
+/**
+ * @param op Operation
+ * @param p First ZDD
+ * @param q Second ZDD
+ * 
+ * @return Union, intersection or difference of \a p and \a q
+ */
+ZddSpace::Zdd ZddSpace::zdd_apply(Operation op, Zdd p, Zdd q)
+{
+	switch (op)
+	{
+	case OP_UNION:
+		if (p == zdd_empty() || p == q) return q;
+		if (q == zdd_empty()) return p;
+		if (p > q) swap(p, q);
+		break;
+	case OP_INTERSECT:
+		if (p == zdd_empty() || q == zdd_empty()) return zdd_empty();
+		if (p == q) return p;
+		if (p > q) swap(p, q);
+		break;
+	default:
+		if (p == zdd_empty() || p == q) return zdd_empty();
+		if (q == zdd_empty()) return p;
+		break;
+	}
+
+	ZddPairCache& cache = nodes.op_cache(op);
+	ZddPairCache::iterator i = cache.find(ZddPair(p, q));
+
+	if (i != cache.end()) return i->second;
+
+	// Leaves are below all variables
+	bool p_top = !zdd_is_leaf(p) && (zdd_is_leaf(q) || zdd_var(p) <= zdd_var(q));
+	bool q_top = !zdd_is_leaf(q) && (zdd_is_leaf(p) || zdd_var(q) <= zdd_var(p));
+
+	Zdd r;
+
+	if (p_top && q_top)
+	{
+		r = zdd_var_then_else(zdd_var(p),
+				      zdd_apply(op, zdd_then(p), zdd_then(q)),
+				      zdd_apply(op, zdd_else(p), zdd_else(q)));
+	}
+	else if (p_top)
+	{
+		// Sets of p containing the variable are not in q
+		r =
+			op == OP_INTERSECT ?
+			zdd_apply(op, zdd_else(p), q):
+			zdd_var_then_else(zdd_var(p), zdd_then(p), zdd_apply(op, zdd_else(p), q));
+	}
+	else
+	{
+		r =
+			op == OP_UNION ?
+			zdd_var_then_else(zdd_var(q), zdd_then(q), zdd_apply(op, p, zdd_else(q))):
+			zdd_apply(op, p, zdd_else(q));
+	}
+
+	cache[ZddPair(p, q)] = r;
+
+	return r;
+}
+
+/// Union
+/**
+ * @param p First ZDD
+ * @param q Second ZDD
+ * 
+ * @return The sets in \a p or \a q
+ */
+ZddSpace::Zdd ZddSpace::zdd_union(Zdd p, Zdd q)
+{
+	return zdd_apply(OP_UNION, p, q);
+}
+
+/// Intersection
+/**
+ * @param p First ZDD
+ * @param q Second ZDD
+ * 
+ * @return The sets in both \a p and \a q
+ */
+ZddSpace::Zdd ZddSpace::zdd_intersect(Zdd p, Zdd q)
+{
+	return zdd_apply(OP_INTERSECT, p, q);
+}
+
+/// Difference
+/**
+ * @param p First ZDD
+ * @param q Second ZDD
+ * 
+ * @return The sets in \a p but not in \a q
+ */
+ZddSpace::Zdd ZddSpace::zdd_diff(Zdd p, Zdd q)
+{
+	return zdd_apply(OP_DIFF, p, q);
+}
+
+/// Toggle variable
+/**
+ * @param p ZDD
+ * @param v Variable
+ * 
+ * @return The sets of \a p with \a v added to the sets without it and removed from the sets with it
+ */
+ZddSpace::Zdd ZddSpace::zdd_change(Zdd p, Var v)
+{
+	ZddCache cache;
+
+	return zdd_change(p, v, cache);
+}
+
+ZddSpace::Zdd ZddSpace::zdd_change(Zdd p, Var v, ZddCache& cache)
+{
+	if (zdd_is_leaf(p) || zdd_var(p) > v) return zdd_var_then_else(v, p, zdd_empty());
+	if (zdd_var(p) == v) return zdd_var_then_else(v, zdd_else(p), zdd_then(p));
+
+	ZddCache::iterator i = cache.find(p);
+
+	if (i != cache.end()) return i->second;
+
+	Zdd r = zdd_var_then_else(zdd_var(p),
+				  zdd_change(zdd_then(p), v, cache),
+				  zdd_change(zdd_else(p), v, cache));
+
+	cache[p] = r;
+
+	return r;
+}
+
+/// Sets with variable
+/**
+ * @param p ZDD
+ * @param v Variable
+ * 
+ * @return The sets of \a p containing \a v, with \a v removed
+ */
+ZddSpace::Zdd ZddSpace::zdd_subset1(Zdd p, Var v)
+{
+	ZddCache cache;
+
+	return zdd_subset1(p, v, cache);
+}
+
+ZddSpace::Zdd ZddSpace::zdd_subset1(Zdd p, Var v, ZddCache& cache)
+{
+	if (zdd_is_leaf(p) || zdd_var(p) > v) return zdd_empty();
+	if (zdd_var(p) == v) return zdd_then(p);
+
+	ZddCache::iterator i = cache.find(p);
+
+	if (i != cache.end()) return i->second;
+
+	Zdd r = zdd_var_then_else(zdd_var(p),
+				  zdd_subset1(zdd_then(p), v, cache),
+				  zdd_subset1(zdd_else(p), v, cache));
+
+	cache[p] = r;
+
+	return r;
+}
+
+/// Sets without variable
+/**
+ * @param p ZDD
+ * @param v Variable
+ * 
+ * @return The sets of \a p not containing \a v
+ */
+ZddSpace::Zdd ZddSpace::zdd_subset0(Zdd p, Var v)
+{
+	ZddCache cache;
+
+	return zdd_subset0(p, v, cache);
+}
+
+ZddSpace::Zdd ZddSpace::zdd_subset0(Zdd p, Var v, ZddCache& cache)
+{
+	if (zdd_is_leaf(p) || zdd_var(p) > v) return p;
+	if (zdd_var(p) == v) return zdd_else(p);
+
+	ZddCache::iterator i = cache.find(p);
+
+	if (i != cache.end()) return i->second;
+
+	Zdd r = zdd_var_then_else(zdd_var(p),
+				  zdd_subset0(zdd_then(p), v, cache),
+				  zdd_subset0(zdd_else(p), v, cache));
+
+	cache[p] = r;
+
+	return r;
+}
+
+/// Count sets
+/**
+ * @param p ZDD
+ * 
+ * @return Number of sets in \a p
+ */
+double ZddSpace::zdd_count(Zdd p)
+{
+	hash_map<Zdd, double> cache;
+
+	return zdd_count(p, cache);
+}
+
+double ZddSpace::zdd_count(Zdd p, hash_map<Zdd, double>& cache)
+{
+	if (zdd_is_leaf(p)) return zdd_leaf_value(p) ? 1 : 0;
+
+	hash_map<Zdd, double>::iterator i = cache.find(p);
+
+	if (i != cache.end()) return i->second;
+
+	double n = zdd_count(zdd_then(p), cache) + zdd_count(zdd_else(p), cache);
+
+	cache[p] = n;
+
+	return n;
+}
+
+/// Count nodes
+/**
+ * @param p ZDD
+ * 
+ * @return Number of nodes reachable from \a p, including leaves
+ */
+unsigned int ZddSpace::zdd_n_nodes(Zdd p)
+{
+	return nodes.get_n_nodes(p);
+}
+
+/// Print ZDD
+/**
+ * @param os Stream to print to
+ * @param p ZDD to print
+ */
+void ZddSpace::zdd_print(ostream &os, Zdd p)
+{
+	if (zdd_is_leaf(p))
+	{
+		os << (zdd_leaf_value(p) ? "{{}}" : "{}");
+	}
+	else
+	{
+		os << "(" << zdd_var(p) << " ";
+		zdd_print(os, zdd_then(p));
+		os << " ";
+		zdd_print(os, zdd_else(p));
+		os << ")";
+	}
+}
+
+/// Get number of nodes
+/**
+ * @return Number of nodes in the space, including leaves
+ */
+unsigned int ZddSpace::get_n_nodes() const
+{
+	return nodes.get_n_nodes();
+}
+
+/// Print statistics
+/**
+ * @param os Stream to print to
+ */
+void ZddSpace::print_statistics(ostream& os) const
+{
+	os << "Nodes: " << nodes.get_n_nodes() << endl;
+	os << "Cached results: " << nodes.get_n_cached() << endl;
+}
+
+}
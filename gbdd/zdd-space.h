@@ -0,0 +1,167 @@
+/*
+ * zdd-space.h: 
+ *
+ * Copyright (C) 2004 Marcus Nilsson (marcusn@it.uu.se)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ * 
+ * Authors:
+ *    Marcus Nilsson (marcusn@it.uu.se)
+ */
+
+
+#ifndef GBDD_ZDD_SPACE_H
+#define GBDD_ZDD_SPACE_H
+
+#include <gbdd/node-table.h>
+
+namespace gbdd
+{
+	/// Space of zero-suppressed decision diagrams
+	/**
+	 * A ZDD represents a family of sets of variables. A node for
+	 * variable v has a then-branch with the sets containing v, with v
+	 * removed, and an else-branch with the sets not containing v.
+	 * Nodes with the empty family as then-branch are removed, so a
+	 * variable not on a path is absent from the sets of the path,
+	 * unlike in a BDD where it may have any value. Sparse families
+	 * therefore need few nodes. The leaves are the empty family and
+	 * the family containing only the empty set.
+	 *
+	 * The node interface mirrors the one of gbdd::Space, but since the
+	 * meaning of a diagram is different this is not a gbdd::Space. The
+	 * nodes are kept in a gbdd::NodeTable with the two leaves first.
+	 */
+	class ZddSpace
+	{
+	public:
+		typedef Space::Var Var;
+		typedef NodeTable<bool>::Node Zdd;
+	private:
+		typedef NodeTable<bool>::NodePair ZddPair;
+		typedef NodeTable<bool>::NodePairCache ZddPairCache;
+		typedef hash_map<Zdd, Zdd> ZddCache;
+
+		/// Operations with a cache kept between calls
+		enum Operation
+		{
+			OP_UNION,
+			OP_INTERSECT,
+			OP_DIFF,
+			N_OPERATIONS
+		};
+
+		NodeTable<bool> nodes;
+
+		Zdd zdd_apply(Operation op, Zdd p, Zdd q);
+		Zdd zdd_change(Zdd p, Var v, ZddCache& cache);
+		Zdd zdd_subset1(Zdd p, Var v, ZddCache& cache);
+		Zdd zdd_subset0(Zdd p, Var v, ZddCache& cache);
+		double zdd_count(Zdd p, hash_map<Zdd, double>& cache);
+	public:
+		ZddSpace();
+
+		void gc();
+
+/// Test for leaf
+/**
+ * @param p ZDD
+ *
+ * @return Whether \a p is one of the leaves
+ */
+		bool zdd_is_leaf(Zdd p) const { return p <= 1; }
+
+/// Value of leaf
+/**
+ * @param p Leaf
+ *
+ * @return False for the empty family, true for the family of the empty set
+ */
+		bool zdd_leaf_value(Zdd p) const
+		{
+			assert(zdd_is_leaf(p));
+			return p == 1;
+		}
+
+/// Get then-branch
+/**
+ * @param p Node, not a leaf
+ *
+ * @return Sets of \a p containing the variable of \a p, with it removed
+ */
+		Zdd zdd_then(Zdd p) const
+		{
+			assert(!zdd_is_leaf(p));
+			return nodes.get_then(p);
+		}
+
+/// Get else-branch
+/**
+ * @param p Node, not a leaf
+ *
+ * @return Sets of \a p not containing the variable of \a p
+ */
+		Zdd zdd_else(Zdd p) const
+		{
+			assert(!zdd_is_leaf(p));
+			return nodes.get_else(p);
+		}
+
+/// Get variable
+/**
+ * @param p Node, not a leaf
+ *
+ * @return Variable of \a p
+ */
+		Var zdd_var(Zdd p) const
+		{
+			assert(!zdd_is_leaf(p));
+			return nodes.get_var(p);
+		}
+
+/// Empty family
+/**
+ * @return The ZDD without sets
+ */
+		Zdd zdd_empty() const { return 0; }
+
+/// Family of the empty set
+/**
+ * @return The ZDD with only the empty set
+ */
+		Zdd zdd_base() const { return 1; }
+
+		Zdd zdd_var_then_else(Var v, Zdd p_then, Zdd p_else);
+		Zdd zdd_single(Var v);
+
+		Zdd zdd_union(Zdd p, Zdd q);
+		Zdd zdd_intersect(Zdd p, Zdd q);
+		Zdd zdd_diff(Zdd p, Zdd q);
+
+		Zdd zdd_change(Zdd p, Var v);
+		Zdd zdd_subset1(Zdd p, Var v);
+		Zdd zdd_subset0(Zdd p, Var v);
+
+		double zdd_count(Zdd p);
+		unsigned int zdd_n_nodes(Zdd p);
+
+		void zdd_print(ostream &os, Zdd p);
+
+		unsigned int get_n_nodes() const;
+		void print_statistics(ostream& os) const;
+	};
+}
+
+#endif /* GBDD_ZDD_SPACE_H */
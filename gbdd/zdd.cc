@@ -0,0 +1,369 @@
+/*
+ * zdd.cc: 
+ *
+ * Copyright (C) 2004 Marcus Nilsson (marcusn@it.uu.se)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ * 
+ * Authors:
+ *    Marcus Nilsson (marcusn@it.uu.se)
+ */
+
+
+#include <gbdd/zdd.h>
+
+namespace gbdd
+{
+
+/// Empty family
+/**
+ * @param space Space of returned ZDD
+ * 
+ * @return The ZDD without sets
+ */
+Zdd Zdd::empty(ZddSpace* space)
+{
+	return Zdd(space, space->zdd_empty());
+}
+
+/// Family of the empty set
+/**
+ * @param space Space of returned ZDD
+ * 
+ * @return The ZDD with only the empty set
+ */
+Zdd Zdd::base(ZddSpace* space)
+{
+	return Zdd(space, space->zdd_base());
+}
+
+/// Family of a singleton set
+/**
+ * @param space Space of returned ZDD
+ * @param v Variable
+ * 
+ * @return The ZDD with only the set {v}
+ */
+Zdd Zdd::single(ZddSpace* space, Var v)
+{
+	return Zdd(space, space->zdd_single(v));
+}
+
+/// Family of one set
+/**
+ * @param space Space of returned ZDD
+ * @param vs Variables of the set, finite
+ * 
+ * @return The ZDD with only the set \a vs
+ */
+Zdd Zdd::single(ZddSpace* space, const Domain& vs)
+{
+	assert(vs.is_finite());
+
+	vector<Var> vars;
+	for (Domain::const_iterator i = vs.begin();i != vs.end();++i)
+	{
+		vars.push_back(*i);
+	}
+
+	ZddSpace::Zdd p = space->zdd_base();
+
+	for (unsigned int i = vars.size();i > 0;--i)
+	{
+		p = space->zdd_var_then_else(vars[i - 1], p, space->zdd_empty());
+	}
+
+	return Zdd(space, p);
+}
+
+ZddSpace::Zdd Zdd::from_bdd(ZddSpace* space, const vector<Var>& vars, unsigned int var_i,
+			    const Bdd& p_bdd, vector<hash_map<Bdd, ZddSpace::Zdd> >& cache)
+{
+	if (var_i == vars.size())
+	{
+		assert(p_bdd.bdd_is_leaf());
+
+		return p_bdd.bdd_leaf_value() ? space->zdd_base() : space->zdd_empty();
+	}
+
+	if (p_bdd.bdd_is_leaf() && !p_bdd.bdd_leaf_value()) return space->zdd_empty();
+
+	hash_map<Bdd, ZddSpace::Zdd>::iterator i = cache[var_i].find(p_bdd);
+
+	if (i != cache[var_i].end()) return i->second;
+
+	Var v = vars[var_i];
+	ZddSpace::Zdd r;
+
+	if (p_bdd.bdd_is_leaf() || p_bdd.bdd_var() > v)
+	{
+		// Variable not in BDD, the sets may or may not contain it
+		ZddSpace::Zdd q = from_bdd(space, vars, var_i + 1, p_bdd, cache);
+
+		r = space->zdd_var_then_else(v, q, q);
+	}
+	else
+	{
+		assert(p_bdd.bdd_var() == v);
+
+		r = space->zdd_var_then_else(v,
+					     from_bdd(space, vars, var_i + 1, p_bdd.bdd_then(), cache),
+					     from_bdd(space, vars, var_i + 1, p_bdd.bdd_else(), cache));
+	}
+
+	cache[var_i][p_bdd] = r;
+
+	return r;
+}
+
+/// Convert BDD to ZDD
+/**
+ * @param space Space of returned ZDD
+ * @param vs Variables, finite and including all variables of \a p
+ * @param p BDD
+ * 
+ * @return The family of the sets of variables in \a vs set in the assignments of \a p
+ */
+Zdd Zdd::from_bdd(ZddSpace* space, const Domain& vs, const Bdd& p)
+{
+	assert(vs.is_finite());
+
+	vector<Var> vars;
+	for (Domain::const_iterator i = vs.begin();i != vs.end();++i)
+	{
+		vars.push_back(*i);
+	}
+
+	vector<hash_map<Bdd, ZddSpace::Zdd> > cache(vars.size());
+
+	return Zdd(space, from_bdd(space, vars, 0, p, cache));
+}
+
+/// Convert relation to ZDD
+/**
+ * @param space Space of returned ZDD
+ * @param r Relation with finite domains
+ * 
+ * @return The relation as a ZDD over the variables of its domains
+ */
+Zdd Zdd::from_relation(ZddSpace* space, const BddRelation& r)
+{
+	return from_bdd(space, r.get_domains().union_all(), r.get_bdd());
+}
+
+Bdd Zdd::to_bdd(Space* bdd_space, const vector<Var>& vars, unsigned int var_i,
+		ZddSpace::Zdd q, vector<hash_map<ZddSpace::Zdd, Bdd> >& cache) const
+{
+	if (var_i == vars.size())
+	{
+		assert(space->zdd_is_leaf(q));
+
+		return Bdd(bdd_space, space->zdd_leaf_value(q));
+	}
+
+	if (q == space->zdd_empty()) return Bdd(bdd_space, false);
+
+	hash_map<ZddSpace::Zdd, Bdd>::iterator i = cache[var_i].find(q);
+
+	if (i != cache[var_i].end()) return i->second;
+
+	Var v = vars[var_i];
+	Bdd r;
+
+	if (space->zdd_is_leaf(q) || space->zdd_var(q) > v)
+	{
+		// Variable suppressed, it is not in any set
+		r = Bdd::var_then_else(bdd_space, v,
+				       Bdd(bdd_space, false),
+				       to_bdd(bdd_space, vars, var_i + 1, q, cache));
+	}
+	else
+	{
+		assert(space->zdd_var(q) == v);
+
+		r = Bdd::var_then_else(bdd_space, v,
+				       to_bdd(bdd_space, vars, var_i + 1, space->zdd_then(q), cache),
+				       to_bdd(bdd_space, vars, var_i + 1, space->zdd_else(q), cache));
+	}
+
+	cache[var_i][q] = r;
+
+	return r;
+}
+
+/// Convert ZDD to BDD
+/**
+ * @param bdd_space Space of returned BDD
+ * @param vs Variables, finite and including all variables of this ZDD
+ * 
+ * @return The BDD true for the assignments of \a vs setting exactly the variables of some set
+ */
+Bdd Zdd::to_bdd(Space* bdd_space, const Domain& vs) const
+{
+	assert(vs.is_finite());
+
+	vector<Var> vars;
+	for (Domain::const_iterator i = vs.begin();i != vs.end();++i)
+	{
+		vars.push_back(*i);
+	}
+
+	vector<hash_map<ZddSpace::Zdd, Bdd> > cache(vars.size());
+
+	return to_bdd(bdd_space, vars, 0, p, cache);
+}
+
+/// Convert ZDD to relation
+/**
+ * @param bdd_space Space of returned relation
+ * @param ds Domains of relation, finite and including all variables of this ZDD
+ * 
+ * @return The relation with tuples encoded by the sets of this ZDD
+ */
+BddRelation Zdd::to_relation(Space* bdd_space, const Domains& ds) const
+{
+	return BddRelation(ds, to_bdd(bdd_space, ds.union_all()));
+}
+
+/// Test for empty family
+/**
+ * @return Whether this ZDD has no sets
+ */
+bool Zdd::is_empty() const
+{
+	return p == space->zdd_empty();
+}
+
+bool Zdd::zdd_is_leaf() const
+{
+	return space->zdd_is_leaf(p);
+}
+
+bool Zdd::zdd_leaf_value() const
+{
+	return space->zdd_leaf_value(p);
+}
+
+Zdd::Var Zdd::zdd_var() const
+{
+	return space->zdd_var(p);
+}
+
+Zdd Zdd::zdd_then() const
+{
+	return Zdd(space, space->zdd_then(p));
+}
+
+Zdd Zdd::zdd_else() const
+{
+	return Zdd(space, space->zdd_else(p));
+}
+
+Zdd Zdd::operator|(const Zdd& p2) const
+{
+	return Zdd(space, space->zdd_union(p, p2.p));
+}
+
+Zdd Zdd::operator&(const Zdd& p2) const
+{
+	return Zdd(space, space->zdd_intersect(p, p2.p));
+}
+
+Zdd Zdd::operator-(const Zdd& p2) const
+{
+	return Zdd(space, space->zdd_diff(p, p2.p));
+}
+
+Zdd& Zdd::operator|=(const Zdd& p2)
+{
+	return *this = *this | p2;
+}
+
+Zdd& Zdd::operator&=(const Zdd& p2)
+{
+	return *this = *this & p2;
+}
+
+Zdd& Zdd::operator-=(const Zdd& p2)
+{
+	return *this = *this - p2;
+}
+
+/// Toggle variable
+/**
+ * @param v Variable
+ * 
+ * @return This family with \a v added to the sets without it and removed from the sets with it
+ */
+Zdd Zdd::change(Var v) const
+{
+	return Zdd(space, space->zdd_change(p, v));
+}
+
+/// Sets with variable
+/**
+ * @param v Variable
+ * 
+ * @return The sets containing \a v, with \a v removed
+ */
+Zdd Zdd::subset1(Var v) const
+{
+	return Zdd(space, space->zdd_subset1(p, v));
+}
+
+/// Sets without variable
+/**
+ * @param v Variable
+ * 
+ * @return The sets not containing \a v
+ */
+Zdd Zdd::subset0(Var v) const
+{
+	return Zdd(space, space->zdd_subset0(p, v));
+}
+
+/// Count sets
+/**
+ * @return Number of sets in this family
+ */
+double Zdd::count() const
+{
+	return space->zdd_count(p);
+}
+
+/// Get number of nodes
+/**
+ * @return Number of nodes of this ZDD, including leaves
+ */
+unsigned int Zdd::get_n_nodes() const
+{
+	return space->zdd_n_nodes(p);
+}
+
+bool operator==(const Zdd& p1, const Zdd& p2)
+{
+	assert(p1.space == p2.space);
+
+	return p1.p == p2.p;
+}
+
+ostream& operator<<(ostream& os, const Zdd& p)
+{
+	p.space->zdd_print(os, p.p);
+
+	return os;
+}
+
+}
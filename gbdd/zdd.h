@@ -0,0 +1,113 @@
+/*
+ * zdd.h: 
+ *
+ * Copyright (C) 2004 Marcus Nilsson (marcusn@it.uu.se)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ * 
+ * Authors:
+ *    Marcus Nilsson (marcusn@it.uu.se)
+ */
+
+
+#ifndef GBDD_ZDD_H
+#define GBDD_ZDD_H
+
+#include <gbdd/zdd-space.h>
+#include <gbdd/bdd-relation.h>
+
+namespace gbdd
+{
+	/// Family of sets of variables as a zero-suppressed decision diagram
+	/**
+	 * A family of sets of variables is the same as a boolean function,
+	 * true for the assignments setting exactly the variables of one of
+	 * the sets. Given the variables to consider, a Zdd can therefore be
+	 * converted to and from a gbdd::Bdd, and a gbdd::BddRelation can be
+	 * stored as a Zdd over the variables of its domains. For sparse
+	 * relations, where few variables are set in each tuple, the Zdd has
+	 * much fewer nodes.
+	 */
+	class Zdd
+	{
+		ZddSpace* space;
+		ZddSpace::Zdd p;
+
+		static ZddSpace::Zdd from_bdd(ZddSpace* space, const vector<Domain::Var>& vars, unsigned int var_i,
+					      const Bdd& p_bdd, vector<hash_map<Bdd, ZddSpace::Zdd> >& cache);
+		Bdd to_bdd(Space* bdd_space, const vector<Domain::Var>& vars, unsigned int var_i,
+			   ZddSpace::Zdd q, vector<hash_map<ZddSpace::Zdd, Bdd> >& cache) const;
+	public:
+		typedef Domain::Var Var;
+
+/// Create ZDD from node
+/**
+ * @param space Space of \a p
+ * @param p Node
+ */
+		Zdd(ZddSpace* space, ZddSpace::Zdd p) : space(space), p(p) {}
+
+		static Zdd empty(ZddSpace* space);
+		static Zdd base(ZddSpace* space);
+		static Zdd single(ZddSpace* space, Var v);
+		static Zdd single(ZddSpace* space, const Domain& vs);
+
+		static Zdd from_bdd(ZddSpace* space, const Domain& vs, const Bdd& p);
+		static Zdd from_relation(ZddSpace* space, const BddRelation& r);
+
+		Bdd to_bdd(Space* bdd_space, const Domain& vs) const;
+		BddRelation to_relation(Space* bdd_space, const Domains& ds) const;
+
+/// Get space
+/**
+ * @return The space of this ZDD
+ */
+		ZddSpace* get_space() const { return space; }
+
+/// Get node
+/**
+ * @return The node of this ZDD in its space
+ */
+		ZddSpace::Zdd get_zdd() const { return p; }
+
+		bool is_empty() const;
+		bool zdd_is_leaf() const;
+		bool zdd_leaf_value() const;
+		Var zdd_var() const;
+		Zdd zdd_then() const;
+		Zdd zdd_else() const;
+
+		Zdd operator|(const Zdd& p2) const;
+		Zdd operator&(const Zdd& p2) const;
+		Zdd operator-(const Zdd& p2) const;
+
+		Zdd& operator|=(const Zdd& p2);
+		Zdd& operator&=(const Zdd& p2);
+		Zdd& operator-=(const Zdd& p2);
+
+		Zdd change(Var v) const;
+		Zdd subset1(Var v) const;
+		Zdd subset0(Var v) const;
+
+		double count() const;
+		unsigned int get_n_nodes() const;
+
+		friend bool operator==(const Zdd& p1, const Zdd& p2);
+		friend bool operator!=(const Zdd& p1, const Zdd& p2) { return !(p1 == p2); }
+		friend ostream& operator<<(ostream& os, const Zdd& p);
+	};
+}
+
+#endif /* GBDD_ZDD_H */